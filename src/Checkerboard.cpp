@@ -0,0 +1,209 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#include <iostream>
+#include <set>
+#include <algorithm>
+#include <math.h>
+#include <stdlib.h>
+
+#include "Checkerboard.h"
+#include "ResistivityBlockOverlay.h"
+
+// Constructer
+Checkerboard::Checkerboard():
+	m_xLength(0.0),
+	m_yLength(0.0),
+	m_zLength(0.0),
+	m_xCellSizeInv(0.0),
+	m_yCellSizeInv(0.0),
+	m_zCellSizeInv(0.0),
+	m_cosAngle(1.0),
+	m_sinAngle(0.0),
+	m_resistivityMin(0.1),
+	m_resistivityMax(1.0e4)
+{
+	m_center.X = 0.0;
+	m_center.Y = 0.0;
+	m_center.Z = 0.0;
+	for( int i = 0; i < 2; ++i ){
+		m_modifiedResistivity[i] = -1.0;
+		m_modifiedMinResistivity[i] = 0.1;
+		m_modifiedMaxResistivity[i] = 1.0e4;
+	}
+}
+
+// Destructer
+Checkerboard::~Checkerboard(){
+}
+
+// Copy constructer
+Checkerboard::Checkerboard(const Checkerboard& rhs){
+	std::cerr << "Error : Copy constructer of the class Checkerboard is not implemented." << std::endl;
+	exit(1);
+}
+
+// Assignment operator
+Checkerboard& Checkerboard::operator=(const Checkerboard& rhs){
+	std::cerr << "Error : Assignment operator of the class Checkerboard is not implemented." << std::endl;
+	exit(1);
+}
+
+// Read parameters of the checkerboard from input stream
+void Checkerboard::readParameters( std::istream& ifs ){
+
+	double xLength(0.0);
+	double yLength(0.0);
+	double zLength(0.0);
+	ifs >> xLength;
+	std::cout << "Length of x axis of the checkerboard [km] : " << xLength << std::endl;
+	ifs >> yLength;
+	std::cout << "Length of y axis of the checkerboard [km] : " << yLength << std::endl;
+	ifs >> zLength;
+	std::cout << "Length of z axis of the checkerboard [km] : " << zLength << std::endl;
+
+	CommonParameters::locationXYZ center = { 0.0, 0.0, 0.0 };
+	ifs >> center.X;
+	std::cout << "X coordinate of the center [km] : " << center.X << std::endl;
+	ifs >> center.Y;
+	std::cout << "Y coordinate of the center [km] : " << center.Y << std::endl;
+	ifs >> center.Z;
+	std::cout << "Z coordinate of the center [km] : " << center.Z << std::endl;
+
+	double angle(0.0);
+	ifs >> angle;
+	std::cout << "Rotation angle [deg.] : " << angle << std::endl;
+
+	double xCellSize(0.0);
+	double yCellSize(0.0);
+	double zCellSize(0.0);
+	ifs >> xCellSize;
+	std::cout << "Size of cells along x axis [km] : " << xCellSize << std::endl;
+	ifs >> yCellSize;
+	std::cout << "Size of cells along y axis [km] : " << yCellSize << std::endl;
+	ifs >> zCellSize;
+	std::cout << "Size of cells along z axis [km] : " << zCellSize << std::endl;
+	if( xCellSize <= 0.0 || yCellSize <= 0.0 || zCellSize <= 0.0 ){
+		std::cerr << "Size of cells must be positive !!" << std::endl;
+		exit(1);
+	}
+
+	ifs >> m_resistivityMin;
+	std::cout << "Minimum resistivity for selecting parameter cells [Ohm-m] :  " << m_resistivityMin << std::endl;
+	ifs >> m_resistivityMax;
+	std::cout << "Maximum resistivity for selecting parameter cells [Ohm-m] :  " << m_resistivityMax << std::endl;
+
+	for( int i = 0; i < 2; ++i ){
+		ifs >> m_modifiedResistivity[i];
+		std::cout << "Modified resistivity of cell type " << i << " [Ohm-m] :  " << m_modifiedResistivity[i] << std::endl;
+		ifs >> m_modifiedMinResistivity[i];
+		std::cout << "Modified minimum resistivity of cell type " << i << " [Ohm-m] :  " << m_modifiedMinResistivity[i] << std::endl;
+		ifs >> m_modifiedMaxResistivity[i];
+		std::cout << "Modified maximum resistivity of cell type " << i << " [Ohm-m] :  " << m_modifiedMaxResistivity[i] << std::endl;
+	}
+
+	center.X *= 1000.0;
+	center.Y *= 1000.0;
+	center.Z *= 1000.0;
+	setParameters( center, xLength * 1000.0, yLength * 1000.0, zLength * 1000.0, angle * CommonParameters::deg2rad,
+		xCellSize * 1000.0, yCellSize * 1000.0, zCellSize * 1000.0 );
+
+}
+
+// Set parameters of the checkerboard
+void Checkerboard::setParameters( const CommonParameters::locationXYZ& center, const double xLength, const double yLength, const double zLength,
+	const double angle, const double xCellSize, const double yCellSize, const double zCellSize ){
+
+	m_center = center;
+	m_xLength = xLength;
+	m_yLength = yLength;
+	m_zLength = zLength;
+	m_xCellSizeInv = 1.0 / xCellSize;
+	m_yCellSizeInv = 1.0 / yCellSize;
+	m_zCellSizeInv = 1.0 / zCellSize;
+	m_cosAngle = cos( - angle );
+	m_sinAngle = sin( - angle );
+
+}
+
+// Get minimum resistivity of the elements to be changed
+double Checkerboard::getResistivityMin() const{
+	return m_resistivityMin;
+}
+
+// Get maximum resistivity of the elements to be changed
+double Checkerboard::getResistivityMax() const{
+	return m_resistivityMax;
+}
+
+// Calculate types of the cells where the specified points are located
+// The type is the parity of the sum of the integer cell indexes in the rotated coordinates.
+void Checkerboard::calcCellTypes( const int numPoints, const double* x, const double* y, const double* z, signed char* types ) const{
+
+	const double xCenter = m_center.X;
+	const double yCenter = m_center.Y;
+	const double zCenter = m_center.Z;
+	const double cosAngle = m_cosAngle;
+	const double sinAngle = m_sinAngle;
+	const double xLength = m_xLength;
+	const double yLength = m_yLength;
+	const double zLength = m_zLength;
+	const double xCellSizeInv = m_xCellSizeInv;
+	const double yCellSizeInv = m_yCellSizeInv;
+	const double zCellSizeInv = m_zCellSizeInv;
+
+#pragma omp simd
+	for( int i = 0; i < numPoints; ++i ){
+		const double xFromCenter = x[i] - xCenter;
+		const double yFromCenter = y[i] - yCenter;
+		// Coordinates from the corner of the checkerboard
+		const double xLocal = xFromCenter * cosAngle - yFromCenter * sinAngle + 0.5 * xLength;
+		const double yLocal = xFromCenter * sinAngle + yFromCenter * cosAngle + 0.5 * yLength;
+		const double zLocal = z[i] - zCenter + 0.5 * zLength;
+		const int inside = ( xLocal >= 0.0 ) & ( xLocal <= xLength ) & ( yLocal >= 0.0 ) & ( yLocal <= yLength ) & ( zLocal >= 0.0 ) & ( zLocal <= zLength );
+		// Coordinates are clamped so that the conversion to integer is always defined
+		const int ix = static_cast<int>( std::min( std::max( xLocal, 0.0 ), xLength ) * xCellSizeInv );
+		const int iy = static_cast<int>( std::min( std::max( yLocal, 0.0 ), yLength ) * yCellSizeInv );
+		const int iz = static_cast<int>( std::min( std::max( zLocal, 0.0 ), zLength ) * zCellSizeInv );
+		types[i] = static_cast<signed char>( inside * ( ( ix + iy + iz ) & 1 ) + inside - 1 );
+	}
+
+}
+
+// Change resistivity of the elements according to the checkerboard and output the modified model
+// Resistivity blocks are changed for the cells of type 0 first and type 1 next.
+void Checkerboard::execute( const bool isTetra, const MeshData* const ptrMeshData, const ResistivityBlock& resistivityBlock,
+	const ElementSelector& selector, const ElementSelector::Eligibility& eligibility, const int iterNum, std::ostream& ofsLog ) const{
+
+	std::set<int> elementsSelected[2];
+	selector.selectElementsByCheckerboard( *this, eligibility, elementsSelected[0], elementsSelected[1] );
+
+	ResistivityBlockOverlay resistivityBlockMod(&resistivityBlock);
+	for( int i = 0; i < 2; ++i ){
+		ofsLog << "Number of the elements of cell type " << i << " : " << elementsSelected[i].size() << std::endl;
+		resistivityBlockMod.changeResistivityOfSelectedElements( elementsSelected[i], m_modifiedResistivity[i], m_modifiedMinResistivity[i], m_modifiedMaxResistivity[i] );
+	}
+	resistivityBlockMod.outputResisitivityBlock(ptrMeshData, iterNum, "");
+	resistivityBlockMod.outputResistivityValuesToBinary(isTetra, ptrMeshData, iterNum, "");
+
+}
@@ -0,0 +1,113 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#ifndef DBLDEF_CHECKERBOARD
+#define DBLDEF_CHECKERBOARD
+
+#include <iostream>
+#include "CommonParameters.h"
+#include "MeshData.h"
+#include "ResistivityBlock.h"
+#include "ElementSelector.h"
+
+// Class of checkerboard model for resolution tests
+// A cuboid volume is tiled with cells whose resistivity values alternate between two values.
+class Checkerboard{
+
+public:
+
+	// Constructer
+	Checkerboard();
+
+	// Destructer
+	~Checkerboard();
+
+	// Read parameters of the checkerboard from input stream
+	void readParameters( std::istream& ifs );
+
+	// Set parameters of the checkerboard
+	// [note] : Lengths are full lengths in meter and the angle is in radian
+	void setParameters( const CommonParameters::locationXYZ& center, const double xLength, const double yLength, const double zLength,
+		const double angle, const double xCellSize, const double yCellSize, const double zCellSize );
+
+	// Get minimum resistivity of the elements to be changed
+	double getResistivityMin() const;
+
+	// Get maximum resistivity of the elements to be changed
+	double getResistivityMax() const;
+
+	// Calculate types of the cells where the specified points are located
+	// [note] : The type is 0 or 1 alternately and -1 for the points outside of the checkerboard.
+	//          This function is written without branches so that it can be vectorized
+	void calcCellTypes( const int numPoints, const double* x, const double* y, const double* z, signed char* types ) const;
+
+	// Change resistivity of the elements according to the checkerboard and output the modified model
+	// [note] : Messages are written to the specified stream
+	void execute( const bool isTetra, const MeshData* const ptrMeshData, const ResistivityBlock& resistivityBlock,
+		const ElementSelector& selector, const ElementSelector::Eligibility& eligibility, const int iterNum, std::ostream& ofsLog ) const;
+
+private:
+
+	// Copy constructer
+	Checkerboard(const Checkerboard& rhs);
+
+	// Copy assignment operator
+	Checkerboard& operator=(const Checkerboard& rhs);
+
+	// Coordinate of the center of the checkerboard
+	CommonParameters::locationXYZ m_center;
+
+	// Lengths of the checkerboard along its axes
+	double m_xLength;
+	double m_yLength;
+	double m_zLength;
+
+	// Reciprocals of the sizes of the cells along the axes of the checkerboard
+	double m_xCellSizeInv;
+	double m_yCellSizeInv;
+	double m_zCellSizeInv;
+
+	// Cosine of the rotation angle for transforming coordinates to the checkerboard
+	double m_cosAngle;
+
+	// Sine of the rotation angle for transforming coordinates to the checkerboard
+	double m_sinAngle;
+
+	// Minimum resistivity of the elements to be changed
+	double m_resistivityMin;
+
+	// Maximum resistivity of the elements to be changed
+	double m_resistivityMax;
+
+	// Modified resistivity of each type of the cells
+	double m_modifiedResistivity[2];
+
+	// Modified minimum resistivity of each type of the cells
+	double m_modifiedMinResistivity[2];
+
+	// Modified maximum resistivity of each type of the cells
+	double m_modifiedMaxResistivity[2];
+
+};
+
+#endif
@@ -56,6 +56,11 @@ struct locationXYZ{
 	double Z;
 };
 
+struct BoundingBox{
+	locationXYZ minCoord;
+	locationXYZ maxCoord;
+};
+
 struct DoubleComplexValues{
 	double realPart;
 	double imagPart;
@@ -0,0 +1,424 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#include <iostream>
+#include <algorithm>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <assert.h>
+
+#include "CompositeRegion.h"
+
+// Constructer
+CompositeRegion::CompositeRegion():
+	Region(),
+	m_expression("")
+{
+	m_regionType = COMPOSITE;
+}
+
+// Destructer
+CompositeRegion::~CompositeRegion(){
+}
+
+// Read primitives and expression from input stream
+void CompositeRegion::readComponents( std::istream& ifs ){
+
+	int numPrimitives(0);
+	ifs >> numPrimitives;
+	std::cout << "Number of primitive regions : " << numPrimitives << std::endl;
+	if( numPrimitives < 1 ){
+		std::cerr << "Number of primitive regions must be positive !!" << std::endl;
+		exit(1);
+	}
+
+	std::vector<Region> primitives( numPrimitives );
+	for( int iPrimitive = 0; iPrimitive < numPrimitives; ++iPrimitive ){
+		std::cout << "Primitive region " << iPrimitive << std::endl;
+		primitives[iPrimitive].readParameters(ifs);
+	}
+
+	std::string expression;
+	ifs >> std::ws;
+	std::getline( ifs, expression );
+	std::cout << "Expression of the region : " << expression << std::endl;
+
+	setComponents( primitives, expression );
+
+}
+
+// Set primitives and expression
+void CompositeRegion::setComponents( const std::vector<Region>& primitives, const std::string& expression ){
+
+	m_primitives = primitives;
+	m_expression = expression;
+	compile();
+
+}
+
+// Determine whether the region is a cuboid whose faces are parallel to the coordinate planes
+bool CompositeRegion::isAxisAlignedCuboid() const{
+	return false;
+}
+
+// Calculate axis-aligned bounding box of the region
+void CompositeRegion::calcBoundingBox( CommonParameters::locationXYZ& minCoord, CommonParameters::locationXYZ& maxCoord ) const{
+
+	CommonParameters::BoundingBox stack[m_maxStackDepth];
+	int depth(0);
+	for( std::vector<Instruction>::const_iterator itr = m_program.begin(); itr != m_program.end(); ++itr ){
+		if( itr->operationCode == PUSH_PRIMITIVE ){
+			m_primitives[itr->primitive].calcBoundingBox( stack[depth].minCoord, stack[depth].maxCoord );
+			++depth;
+			continue;
+		}
+		--depth;
+		CommonParameters::BoundingBox& lhs = stack[depth - 1];
+		const CommonParameters::BoundingBox& rhs = stack[depth];
+		switch( itr->operationCode ){
+			case UNION:
+				lhs.minCoord.X = std::min( lhs.minCoord.X, rhs.minCoord.X );
+				lhs.minCoord.Y = std::min( lhs.minCoord.Y, rhs.minCoord.Y );
+				lhs.minCoord.Z = std::min( lhs.minCoord.Z, rhs.minCoord.Z );
+				lhs.maxCoord.X = std::max( lhs.maxCoord.X, rhs.maxCoord.X );
+				lhs.maxCoord.Y = std::max( lhs.maxCoord.Y, rhs.maxCoord.Y );
+				lhs.maxCoord.Z = std::max( lhs.maxCoord.Z, rhs.maxCoord.Z );
+				break;
+			case INTERSECTION:
+				// The box can be empty, i.e. the minimum can exceed the maximum
+				lhs.minCoord.X = std::max( lhs.minCoord.X, rhs.minCoord.X );
+				lhs.minCoord.Y = std::max( lhs.minCoord.Y, rhs.minCoord.Y );
+				lhs.minCoord.Z = std::max( lhs.minCoord.Z, rhs.minCoord.Z );
+				lhs.maxCoord.X = std::min( lhs.maxCoord.X, rhs.maxCoord.X );
+				lhs.maxCoord.Y = std::min( lhs.maxCoord.Y, rhs.maxCoord.Y );
+				lhs.maxCoord.Z = std::min( lhs.maxCoord.Z, rhs.maxCoord.Z );
+				break;
+			default:
+				// Difference is not larger than the minuend
+				break;
+		}
+	}
+	assert( depth == 1 );
+	minCoord = stack[0].minCoord;
+	maxCoord = stack[0].maxCoord;
+
+}
+
+// Determine whether the specified box is located inside or outside of the region
+int CompositeRegion::locateBox( const CommonParameters::BoundingBox& box ) const{
+
+	int locations[m_maxProgramLength];
+	locateBoxBySubExpressions( box, locations );
+	return locations[ m_program.size() - 1 ];
+
+}
+
+// Determine whether the specified point is located in the region
+bool CompositeRegion::inRegion( const CommonParameters::locationXYZ& coord ) const{
+
+	// The program is evaluated directly because locating the sub-expressions costs more than testing one point
+	bool stack[m_maxStackDepth];
+	int depth(0);
+	const int numInstructions = static_cast<int>( m_program.size() );
+	for( int i = 0; i < numInstructions; ++i ){
+		const Instruction& instruction = m_program[i];
+		if( instruction.operationCode == PUSH_PRIMITIVE ){
+			stack[depth++] = m_primitives[instruction.primitive].inRegion( coord );
+			continue;
+		}
+		--depth;
+		switch( instruction.operationCode ){
+			case UNION:
+				stack[depth - 1] = stack[depth - 1] || stack[depth];
+				break;
+			case INTERSECTION:
+				stack[depth - 1] = stack[depth - 1] && stack[depth];
+				break;
+			default:
+				stack[depth - 1] = stack[depth - 1] && !stack[depth];
+				break;
+		}
+	}
+	assert( depth == 1 );
+	return stack[0];
+
+}
+
+// Determine whether the specified points are located in the region
+void CompositeRegion::inRegion( const int numPoints, const double* x, const double* y, const double* z, unsigned char* flags ) const{
+
+	for( int iBegin = 0; iBegin < numPoints; iBegin += m_batchSize ){
+		const int num = std::min( m_batchSize, numPoints - iBegin );
+		inRegionBatch( num, x + iBegin, y + iBegin, z + iBegin, flags + iBegin );
+	}
+
+}
+
+// Compile the expression into the postfix program by the shunting-yard algorithm
+void CompositeRegion::compile(){
+
+	m_program.clear();
+
+	// Stack of operators and left parentheses
+	std::vector<char> operators;
+	// Stack of the first instructions of the operands
+	std::vector<int> operands;
+	int maxDepth(0);
+	bool isOperandExpected(true);
+
+	const std::string& exp = m_expression;
+	std::string::size_type pos(0);
+	while( pos <= exp.size() ){
+		const char c = pos < exp.size() ? exp[pos] : '\0';
+		if( isspace(c) ){
+			++pos;
+			continue;
+		}
+		if( isdigit(c) ){
+			if( !isOperandExpected ){
+				std::cerr << "Operator is missing at position " << pos << " of region expression : " << exp << std::endl;
+				exit(1);
+			}
+			int primitive(0);
+			while( pos < exp.size() && isdigit(exp[pos]) ){
+				primitive = primitive * 10 + ( exp[pos] - '0' );
+				++pos;
+			}
+			if( primitive >= static_cast<int>( m_primitives.size() ) ){
+				std::cerr << "Primitive region " << primitive << " does not exist in region expression : " << exp << std::endl;
+				exit(1);
+			}
+			const Instruction instruction = { PUSH_PRIMITIVE, primitive, static_cast<int>( m_program.size() ) };
+			operands.push_back( instruction.first );
+			m_program.push_back( instruction );
+			maxDepth = std::max( maxDepth, static_cast<int>( operands.size() ) );
+			isOperandExpected = false;
+			continue;
+		}
+		if( c == '(' ){
+			if( !isOperandExpected ){
+				std::cerr << "Operator is missing at position " << pos << " of region expression : " << exp << std::endl;
+				exit(1);
+			}
+			operators.push_back(c);
+			++pos;
+			continue;
+		}
+		if( c != ')' && c != '|' && c != '+' && c != '&' && c != '-' && c != '\0' ){
+			std::cerr << "Invalid character '" << c << "' in region expression : " << exp << std::endl;
+			exit(1);
+		}
+		if( isOperandExpected ){
+			std::cerr << "Operand is missing at position " << pos << " of region expression : " << exp << std::endl;
+			exit(1);
+		}
+		// Intersection precedes union and difference, and all the operators are left-associative
+		const int precedence = ( c == '&' ) ? 2 : ( ( c == ')' || c == '\0' ) ? 0 : 1 );
+		while( !operators.empty() && operators.back() != '(' ){
+			const int precedenceTop = ( operators.back() == '&' ) ? 2 : 1;
+			if( precedenceTop < precedence ){
+				break;
+			}
+			const char op = operators.back();
+			operators.pop_back();
+			operands.pop_back();
+			const Instruction instruction = { op == '&' ? INTERSECTION : ( op == '-' ? DIFFERENCE : UNION ), -1, operands.back() };
+			m_program.push_back( instruction );
+		}
+		if( c == ')' ){
+			if( operators.empty() ){
+				std::cerr << "Parentheses are not balanced in region expression : " << exp << std::endl;
+				exit(1);
+			}
+			operators.pop_back();
+		}else if( c == '\0' ){
+			if( !operators.empty() ){
+				std::cerr << "Parentheses are not balanced in region expression : " << exp << std::endl;
+				exit(1);
+			}
+			break;
+		}else{
+			operators.push_back(c);
+			isOperandExpected = true;
+		}
+		++pos;
+	}
+
+	assert( operands.size() == 1 );
+	if( maxDepth > m_maxStackDepth || static_cast<int>( m_program.size() ) > m_maxProgramLength ){
+		std::cerr << "Region expression is too complicated : " << exp << std::endl;
+		exit(1);
+	}
+
+}
+
+// Locate the specified box against all the sub-expressions
+void CompositeRegion::locateBoxBySubExpressions( const CommonParameters::BoundingBox& box, int* locations ) const{
+
+	int stack[m_maxStackDepth];
+	int depth(0);
+	const int numInstructions = static_cast<int>( m_program.size() );
+	for( int i = 0; i < numInstructions; ++i ){
+		const Instruction& instruction = m_program[i];
+		if( instruction.operationCode == PUSH_PRIMITIVE ){
+			stack[depth++] = m_primitives[instruction.primitive].locateBox(box);
+			locations[i] = stack[depth - 1];
+			continue;
+		}
+		--depth;
+		const int lhs = stack[depth - 1];
+		const int rhs = stack[depth];
+		int result(CROSSING_BOUNDARY);
+		switch( instruction.operationCode ){
+			case UNION:
+				if( lhs == INSIDE_OF_REGION || rhs == INSIDE_OF_REGION ){
+					result = INSIDE_OF_REGION;
+				}else if( lhs == OUTSIDE_OF_REGION && rhs == OUTSIDE_OF_REGION ){
+					result = OUTSIDE_OF_REGION;
+				}
+				break;
+			case INTERSECTION:
+				if( lhs == OUTSIDE_OF_REGION || rhs == OUTSIDE_OF_REGION ){
+					result = OUTSIDE_OF_REGION;
+				}else if( lhs == INSIDE_OF_REGION && rhs == INSIDE_OF_REGION ){
+					result = INSIDE_OF_REGION;
+				}
+				break;
+			default:
+				if( lhs == OUTSIDE_OF_REGION || rhs == INSIDE_OF_REGION ){
+					result = OUTSIDE_OF_REGION;
+				}else if( lhs == INSIDE_OF_REGION && rhs == OUTSIDE_OF_REGION ){
+					result = INSIDE_OF_REGION;
+				}
+				break;
+		}
+		stack[depth - 1] = result;
+		locations[i] = result;
+	}
+
+}
+
+// Determine whether the points are located in the region
+// The sub-expressions whose results are determined by the bounding box of the points are not evaluated point by point.
+void CompositeRegion::inRegionBatch( const int numPoints, const double* x, const double* y, const double* z, unsigned char* flags ) const{
+
+	assert( numPoints <= m_batchSize );
+	if( numPoints <= 0 ){
+		return;
+	}
+
+	CommonParameters::BoundingBox box = { { x[0], y[0], z[0] }, { x[0], y[0], z[0] } };
+	for( int i = 1; i < numPoints; ++i ){
+		box.minCoord.X = std::min( box.minCoord.X, x[i] );
+		box.minCoord.Y = std::min( box.minCoord.Y, y[i] );
+		box.minCoord.Z = std::min( box.minCoord.Z, z[i] );
+		box.maxCoord.X = std::max( box.maxCoord.X, x[i] );
+		box.maxCoord.Y = std::max( box.maxCoord.Y, y[i] );
+		box.maxCoord.Z = std::max( box.maxCoord.Z, z[i] );
+	}
+
+	const int numInstructions = static_cast<int>( m_program.size() );
+	int locations[m_maxProgramLength];
+	locateBoxBySubExpressions( box, locations );
+	if( locations[numInstructions - 1] != CROSSING_BOUNDARY ){
+		memset( flags, locations[numInstructions - 1] == INSIDE_OF_REGION ? 1 : 0, numPoints );
+		return;
+	}
+
+	// Instruction from which the largest determined sub-expression begins
+	int lastOfDeterminedSubExpression[m_maxProgramLength];
+	for( int i = 0; i < numInstructions; ++i ){
+		lastOfDeterminedSubExpression[i] = -1;
+	}
+	for( int i = 0; i < numInstructions; ++i ){
+		if( locations[i] != CROSSING_BOUNDARY ){
+			// Enclosing sub-expressions beginning from the same instruction come later
+			lastOfDeterminedSubExpression[ m_program[i].first ] = i;
+		}
+	}
+
+	unsigned char stack[m_maxStackDepth][m_batchSize];
+	int depth(0);
+	int i(0);
+	while( i < numInstructions ){
+		const int last = lastOfDeterminedSubExpression[i];
+		if( last >= 0 ){
+			memset( stack[depth++], locations[last] == INSIDE_OF_REGION ? 1 : 0, numPoints );
+			i = last + 1;
+			continue;
+		}
+		const Instruction& instruction = m_program[i];
+		if( instruction.operationCode == PUSH_PRIMITIVE ){
+			m_primitives[instruction.primitive].inRegion( numPoints, x, y, z, stack[depth++] );
+			++i;
+			continue;
+		}
+		--depth;
+		unsigned char* const lhs = stack[depth - 1];
+		const unsigned char* const rhs = stack[depth];
+		switch( instruction.operationCode ){
+			case UNION:
+#pragma omp simd
+				for( int j = 0; j < numPoints; ++j ){
+					lhs[j] |= rhs[j];
+				}
+				break;
+			case INTERSECTION:
+#pragma omp simd
+				for( int j = 0; j < numPoints; ++j ){
+					lhs[j] &= rhs[j];
+				}
+				break;
+			default:
+#pragma omp simd
+				for( int j = 0; j < numPoints; ++j ){
+					lhs[j] &= rhs[j] ^ 1;
+				}
+				break;
+		}
+		++i;
+	}
+	assert( depth == 1 );
+	memcpy( flags, stack[0], numPoints );
+
+}
+
+// Write parameters of the region in canonical form
+void CompositeRegion::writeCanonicalParameters( std::ostream& ofs ) const{
+
+	ofs << "COMPOSITE " << m_primitives.size() << std::endl;
+	for( std::vector<Region>::const_iterator itr = m_primitives.begin(); itr != m_primitives.end(); ++itr ){
+		itr->writeCanonicalParameters(ofs);
+	}
+	ofs << "PROGRAM";
+	for( std::vector<Instruction>::const_iterator itr = m_program.begin(); itr != m_program.end(); ++itr ){
+		if( itr->operationCode == PUSH_PRIMITIVE ){
+			ofs << " P" << itr->primitive;
+		}else{
+			ofs << " O" << itr->operationCode;
+		}
+	}
+	ofs << std::endl;
+
+}
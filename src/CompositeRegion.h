@@ -0,0 +1,126 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#ifndef DBLDEF_COMPOSITE_REGION
+#define DBLDEF_COMPOSITE_REGION
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Region.h"
+
+// Class of region composed of primitive regions by union, intersection and difference
+// The expression such as "(0|1)-2&3" refers to the primitives by their indexes.
+//   | or + : Union
+//   &      : Intersection ( evaluated before union and difference )
+//   -      : Difference
+// The expression is compiled into a postfix program. The program is evaluated for a batch of points
+// after the primitives have been located against the bounding box of the batch, so that the points are
+// not tested for the sub-expressions whose results are determined by the bounding box.
+// A single point is tested by evaluating the program directly without locating the sub-expressions.
+class CompositeRegion : public Region{
+
+public:
+
+	// Constructer
+	CompositeRegion();
+
+	// Destructer
+	virtual ~CompositeRegion();
+
+	// Read primitives and expression from input stream
+	void readComponents( std::istream& ifs );
+
+	// Set primitives and expression
+	void setComponents( const std::vector<Region>& primitives, const std::string& expression );
+
+	// Determine whether the region is a cuboid whose faces are parallel to the coordinate planes
+	virtual bool isAxisAlignedCuboid() const;
+
+	// Calculate axis-aligned bounding box of the region
+	virtual void calcBoundingBox( CommonParameters::locationXYZ& minCoord, CommonParameters::locationXYZ& maxCoord ) const;
+
+	// Determine whether the specified box is located inside or outside of the region
+	virtual int locateBox( const CommonParameters::BoundingBox& box ) const;
+
+	// Determine whether the specified point is located in the region
+	virtual bool inRegion( const CommonParameters::locationXYZ& coord ) const;
+
+	// Determine whether the specified points are located in the region
+	virtual void inRegion( const int numPoints, const double* x, const double* y, const double* z, unsigned char* flags ) const;
+
+	// Write parameters of the region in canonical form
+	// [note] : The postfix program is written instead of the expression
+	virtual void writeCanonicalParameters( std::ostream& ofs ) const;
+
+private:
+
+	enum OperationCode{
+		PUSH_PRIMITIVE = 0,
+		UNION,
+		INTERSECTION,
+		DIFFERENCE,
+	};
+
+	// Instruction of the postfix program
+	struct Instruction{
+		// Operation code
+		int operationCode;
+		// Index of the primitive for PUSH_PRIMITIVE
+		int primitive;
+		// Index of the first instruction of the sub-expression ending with this instruction
+		int first;
+	};
+
+	// Maximum depth of the stack of the program
+	static const int m_maxStackDepth = 32;
+
+	// Maximum number of instructions of the program
+	static const int m_maxProgramLength = 256;
+
+	// Number of points evaluated at once
+	static const int m_batchSize = 256;
+
+	// Primitive regions
+	std::vector<Region> m_primitives;
+
+	// Expression of the region
+	std::string m_expression;
+
+	// Postfix program
+	std::vector<Instruction> m_program;
+
+	// Compile the expression into the postfix program
+	void compile();
+
+	// Locate the specified box against all the sub-expressions
+	// [note] : The location of the sub-expression ending with each instruction is stored
+	void locateBoxBySubExpressions( const CommonParameters::BoundingBox& box, int* locations ) const;
+
+	// Determine whether the points are located in the region
+	// [note] : The number of points must not exceed the batch size
+	void inRegionBatch( const int numPoints, const double* x, const double* y, const double* z, unsigned char* flags ) const;
+
+};
+
+#endif
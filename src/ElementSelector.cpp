@@ -0,0 +1,472 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <assert.h>
+
+#include "ElementSelector.h"
+#include "MeshDataNonConformingHexaElement.h"
+#include "Checkerboard.h"
+#include "PerformanceReport.h"
+#include "Tracer.h"
+
+// Constructer
+ElementSelector::ElementSelector( const MeshData* const ptrMeshData ):
+	m_ptrMeshData(ptrMeshData),
+	m_numElemTotal(ptrMeshData->getNumElemTotal()),
+	m_xCenter(NULL),
+	m_yCenter(NULL),
+	m_zCenter(NULL),
+	m_ownsCenters(true),
+	m_positionOfElement(NULL)
+{
+	calcCentersOfElements();
+}
+
+// Constructer with coordinates of element centers in the processing order calculated beforehand
+ElementSelector::ElementSelector( const MeshData* const ptrMeshData, const double* const xCenter, const double* const yCenter, const double* const zCenter ):
+	m_ptrMeshData(ptrMeshData),
+	m_numElemTotal(ptrMeshData->getNumElemTotal()),
+	m_xCenter(xCenter),
+	m_yCenter(yCenter),
+	m_zCenter(zCenter),
+	m_ownsCenters(false),
+	m_positionOfElement(NULL)
+{
+
+	if( xCenter == NULL || yCenter == NULL || zCenter == NULL ){
+		m_ownsCenters = true;
+		calcCentersOfElements();
+		return;
+	}
+
+	m_positionOfElement = new int[m_numElemTotal];
+#pragma omp parallel for
+	for( int i = 0; i < m_numElemTotal; ++i ){
+		m_positionOfElement[ m_ptrMeshData->getElementOrder(i) ] = i;
+	}
+
+}
+
+// Destructer
+ElementSelector::~ElementSelector(){
+
+	if( m_ownsCenters ){
+		if( m_xCenter != NULL ){
+			delete[] m_xCenter;
+		}
+		if( m_yCenter != NULL ){
+			delete[] m_yCenter;
+		}
+		if( m_zCenter != NULL ){
+			delete[] m_zCenter;
+		}
+	}
+	m_xCenter = NULL;
+	m_yCenter = NULL;
+	m_zCenter = NULL;
+
+	if( m_positionOfElement != NULL ){
+		delete[] m_positionOfElement;
+		m_positionOfElement = NULL;
+	}
+
+}
+
+// Calculate coordinates of element centers in the processing order
+void ElementSelector::calcCentersOfElements(){
+
+	PerformanceReport::Timer timer(PerformanceReport::PREPROCESSING);
+
+	double* xCenter = new double[m_numElemTotal];
+	double* yCenter = new double[m_numElemTotal];
+	double* zCenter = new double[m_numElemTotal];
+	m_positionOfElement = new int[m_numElemTotal];
+#pragma omp parallel
+	{
+		Tracer::Event event("worker", "element centers");
+#pragma omp for nowait
+		for( int i = 0; i < m_numElemTotal; ++i ){
+			const int iElem = m_ptrMeshData->getElementOrder(i);
+			const CommonParameters::locationXYZ center = m_ptrMeshData->getElementCenter(iElem);
+			xCenter[i] = center.X;
+			yCenter[i] = center.Y;
+			zCenter[i] = center.Z;
+			m_positionOfElement[iElem] = i;
+		}
+	}
+	m_xCenter = xCenter;
+	m_yCenter = yCenter;
+	m_zCenter = zCenter;
+
+}
+
+// Copy constructer
+ElementSelector::ElementSelector(const ElementSelector& rhs){
+	std::cerr << "Error : Copy constructer of the class ElementSelector is not implemented." << std::endl;
+	exit(1);
+}
+
+// Assignment operator
+ElementSelector& ElementSelector::operator=(const ElementSelector& rhs){
+	std::cerr << "Error : Assignment operator of the class ElementSelector is not implemented." << std::endl;
+	exit(1);
+}
+
+// Calculate resistivity blocks and elements which can be selected
+void ElementSelector::calcEligibility( const ResistivityBlock& resistivityBlock, const double resistivityMin, const double resistivityMax,
+	Eligibility& eligibility ) const{
+
+	PerformanceReport::Timer timer(PerformanceReport::PREPROCESSING);
+
+	eligibility.resistivityMin = resistivityMin;
+	eligibility.resistivityMax = resistivityMax;
+	eligibility.blocks.clear();
+	eligibility.positions.clear();
+
+	const int nBlk = resistivityBlock.getNumResistivityBlockTotal();
+	for( int iBlk = 0; iBlk < nBlk; ++iBlk ){
+		if( !isEligibleBlock( resistivityBlock, iBlk, resistivityMin, resistivityMax ) ){
+			continue;
+		}
+		eligibility.blocks.push_back(iBlk);
+		const std::set<int>& elements = resistivityBlock.getElementsFromBlock(iBlk);
+		for( std::set<int>::const_iterator itr = elements.begin(); itr != elements.end(); ++itr ){
+			eligibility.positions.push_back( m_positionOfElement[*itr] );
+		}
+	}
+	std::sort( eligibility.positions.begin(), eligibility.positions.end() );
+
+}
+
+// Select elements located in the region
+void ElementSelector::selectElements( const ResistivityBlock& resistivityBlock, const Region& region,
+	const SelectionParameters& params, std::set<int>& elementsSelected ) const{
+
+	Eligibility eligibility;
+	calcEligibility( resistivityBlock, params.resistivityMin, params.resistivityMax, eligibility );
+	selectElements( resistivityBlock, region, params, eligibility, elementsSelected );
+
+}
+
+// Select elements located in the region with precomputed eligibility
+// Resistivity blocks are first located against the region by the bounding boxes of their element centers.
+// Elements are tested one by one only for the blocks crossing the boundary of the region.
+void ElementSelector::selectElements( const ResistivityBlock& resistivityBlock, const Region& region,
+	const SelectionParameters& params, const Eligibility& eligibility, std::set<int>& elementsSelected ) const{
+
+	assert( eligibility.resistivityMin == params.resistivityMin );
+	assert( eligibility.resistivityMax == params.resistivityMax );
+
+	PerformanceReport::Timer timer(PerformanceReport::SELECTION);
+
+	std::vector<unsigned char> isSelected( m_numElemTotal, 0 );
+
+	if( params.selectionMode == VOLUME_FRACTION ){
+		selectElementsByVolumeFraction( region, params, eligibility.positions, isSelected );
+		PerformanceReport::addCount(PerformanceReport::ELEMENTS_TESTED, static_cast<long long>( eligibility.positions.size() ));
+	}else{
+		const int numBlocks = static_cast<int>( eligibility.blocks.size() );
+		std::vector<unsigned char> toBeTested( numBlocks, 0 );
+#pragma omp parallel for schedule(dynamic, 64)
+		for( int i = 0; i < numBlocks; ++i ){
+			const int iBlk = eligibility.blocks[i];
+			switch( region.locateBox( resistivityBlock.getBoundingBoxOfBlock(iBlk) ) ){
+				case Region::INSIDE_OF_REGION:
+					{
+						const std::set<int>& elements = resistivityBlock.getElementsFromBlock(iBlk);
+						for( std::set<int>::const_iterator itr = elements.begin(); itr != elements.end(); ++itr ){
+							isSelected[*itr] = 1;
+						}
+					}
+					break;
+				case Region::CROSSING_BOUNDARY:
+					toBeTested[i] = 1;
+					break;
+				default:
+					break;
+			}
+		}
+
+		// Positions of the elements to be tested in the processing order
+		std::vector<int> positions;
+		for( int i = 0; i < numBlocks; ++i ){
+			if( toBeTested[i] == 0 ){
+				continue;
+			}
+			const std::set<int>& elements = resistivityBlock.getElementsFromBlock( eligibility.blocks[i] );
+			for( std::set<int>::const_iterator itr = elements.begin(); itr != elements.end(); ++itr ){
+				positions.push_back( m_positionOfElement[*itr] );
+			}
+		}
+		std::sort( positions.begin(), positions.end() );
+		selectElementsByCenter( region, positions, isSelected );
+		PerformanceReport::addCount(PerformanceReport::ELEMENTS_TESTED, static_cast<long long>( positions.size() ));
+	}
+
+	long long numAccepted(0);
+	for( int iElem = 0; iElem < m_numElemTotal; ++iElem ){
+		if( isSelected[iElem] != 0 ){
+			elementsSelected.insert( elementsSelected.end(), iElem );
+			++numAccepted;
+		}
+	}
+	PerformanceReport::addCount(PerformanceReport::ELEMENTS_ACCEPTED, numAccepted);
+
+}
+
+// Select elements located in the region by the serial reference implementation
+void ElementSelector::selectElementsReference( const ResistivityBlock& resistivityBlock, const Region& region,
+	const SelectionParameters& params, std::set<int>& elementsSelected ) const{
+
+	for( int iElem = 0; iElem < m_numElemTotal; ++iElem ){
+		const int iBlk = resistivityBlock.getBlockFromElement(iElem);
+		if( !isEligibleBlock( resistivityBlock, iBlk, params.resistivityMin, params.resistivityMax ) ){
+			continue;
+		}
+		if( params.selectionMode == VOLUME_FRACTION ){
+			if( calcVolumeFractionInRegion( iElem, region, params.numGaussPoints ) > params.thresholdVolumeFraction ){
+				elementsSelected.insert( elementsSelected.end(), iElem );
+			}
+		}else if( region.inRegion( m_ptrMeshData->getElementCenter(iElem) ) ){
+			elementsSelected.insert( elementsSelected.end(), iElem );
+		}
+	}
+
+}
+
+// Select elements whose centers are located in the region
+void ElementSelector::selectElementsByCenter( const Region& region, const std::vector<int>& positions, std::vector<unsigned char>& isSelected ) const{
+
+	const int numPositions = static_cast<int>( positions.size() );
+	const int numChunks = ( numPositions + m_chunkSize - 1 ) / m_chunkSize;
+
+#pragma omp parallel
+	{
+		double x[m_chunkSize];
+		double y[m_chunkSize];
+		double z[m_chunkSize];
+		unsigned char flags[m_chunkSize];
+		Tracer::Event event("worker", "element test");
+#pragma omp for schedule(dynamic) nowait
+		for( int iChunk = 0; iChunk < numChunks; ++iChunk ){
+			const int iBegin = iChunk * m_chunkSize;
+			const int num = std::min( m_chunkSize, numPositions - iBegin );
+			for( int i = 0; i < num; ++i ){
+				const int pos = positions[ iBegin + i ];
+				x[i] = m_xCenter[pos];
+				y[i] = m_yCenter[pos];
+				z[i] = m_zCenter[pos];
+			}
+			region.inRegion( num, x, y, z, flags );
+			for( int i = 0; i < num; ++i ){
+				if( flags[i] != 0 ){
+					isSelected[ m_ptrMeshData->getElementOrder( positions[ iBegin + i ] ) ] = 1;
+				}
+			}
+		}
+	}
+
+}
+
+// Select elements whose centers are located in each type of the cells of a checkerboard
+// The cell of each element is determined in one sweep without testing the cells one by one.
+void ElementSelector::selectElementsByCheckerboard( const Checkerboard& checkerboard, const Eligibility& eligibility,
+	std::set<int>& elementsSelectedType0, std::set<int>& elementsSelectedType1 ) const{
+
+	PerformanceReport::Timer timer(PerformanceReport::SELECTION);
+
+	const int numPositions = static_cast<int>( eligibility.positions.size() );
+	const int numChunks = ( numPositions + m_chunkSize - 1 ) / m_chunkSize;
+	std::vector<signed char> cellTypes( m_numElemTotal, -1 );
+
+#pragma omp parallel
+	{
+		double x[m_chunkSize];
+		double y[m_chunkSize];
+		double z[m_chunkSize];
+		signed char types[m_chunkSize];
+		Tracer::Event event("worker", "checkerboard sweep");
+#pragma omp for schedule(dynamic) nowait
+		for( int iChunk = 0; iChunk < numChunks; ++iChunk ){
+			const int iBegin = iChunk * m_chunkSize;
+			const int num = std::min( m_chunkSize, numPositions - iBegin );
+			for( int i = 0; i < num; ++i ){
+				const int pos = eligibility.positions[ iBegin + i ];
+				x[i] = m_xCenter[pos];
+				y[i] = m_yCenter[pos];
+				z[i] = m_zCenter[pos];
+			}
+			checkerboard.calcCellTypes( num, x, y, z, types );
+			for( int i = 0; i < num; ++i ){
+				cellTypes[ m_ptrMeshData->getElementOrder( eligibility.positions[ iBegin + i ] ) ] = types[i];
+			}
+		}
+	}
+
+	long long numAccepted(0);
+	for( int iElem = 0; iElem < m_numElemTotal; ++iElem ){
+		if( cellTypes[iElem] == 0 ){
+			elementsSelectedType0.insert( elementsSelectedType0.end(), iElem );
+			++numAccepted;
+		}else if( cellTypes[iElem] == 1 ){
+			elementsSelectedType1.insert( elementsSelectedType1.end(), iElem );
+			++numAccepted;
+		}
+	}
+	PerformanceReport::addCount(PerformanceReport::ELEMENTS_TESTED, numPositions);
+	PerformanceReport::addCount(PerformanceReport::ELEMENTS_ACCEPTED, numAccepted);
+
+}
+
+// Calculate membership of the elements whose centers are located in the indexed regions
+// All the regions are treated in one sweep over the elements, and each center is tested
+// only against the regions whose bounding boxes contain it.
+void ElementSelector::calcRegionMembership( const RegionIndex& regionIndex, const Eligibility& eligibility, RegionIndex::Membership& membership ) const{
+
+	PerformanceReport::Timer timer(PerformanceReport::SELECTION);
+
+	const int numPositions = static_cast<int>( eligibility.positions.size() );
+	const int numChunks = ( numPositions + m_chunkSize - 1 ) / m_chunkSize;
+
+	// Regions containing the elements of each chunk are stored separately and merged afterward
+	std::vector< std::vector<int> > regionsOfChunks( numChunks );
+	membership.numRegions = regionIndex.getNumRegions();
+	membership.offsets.assign( m_numElemTotal + 1, 0 );
+
+#pragma omp parallel for schedule(dynamic)
+	for( int iChunk = 0; iChunk < numChunks; ++iChunk ){
+		const int iBegin = iChunk * m_chunkSize;
+		const int num = std::min( m_chunkSize, numPositions - iBegin );
+		std::vector<int>& regionsFound = regionsOfChunks[iChunk];
+		for( int i = 0; i < num; ++i ){
+			const int pos = eligibility.positions[ iBegin + i ];
+			const int numFoundBefore = static_cast<int>( regionsFound.size() );
+			regionIndex.findRegionsContainingPoint( m_xCenter[pos], m_yCenter[pos], m_zCenter[pos], regionsFound );
+			membership.offsets[ m_ptrMeshData->getElementOrder(pos) + 1 ] = static_cast<int>( regionsFound.size() ) - numFoundBefore;
+		}
+	}
+
+	long long numAccepted(0);
+	for( int iElem = 0; iElem < m_numElemTotal; ++iElem ){
+		if( membership.offsets[iElem + 1] > 0 ){
+			++numAccepted;
+		}
+		membership.offsets[iElem + 1] += membership.offsets[iElem];
+	}
+	PerformanceReport::addCount(PerformanceReport::ELEMENTS_TESTED, numPositions);
+	PerformanceReport::addCount(PerformanceReport::ELEMENTS_ACCEPTED, numAccepted);
+	membership.regions.resize( membership.offsets[m_numElemTotal] );
+
+#pragma omp parallel for schedule(dynamic)
+	for( int iChunk = 0; iChunk < numChunks; ++iChunk ){
+		const int iBegin = iChunk * m_chunkSize;
+		const int num = std::min( m_chunkSize, numPositions - iBegin );
+		const std::vector<int>& regionsFound = regionsOfChunks[iChunk];
+		int index(0);
+		for( int i = 0; i < num; ++i ){
+			const int iElem = m_ptrMeshData->getElementOrder( eligibility.positions[ iBegin + i ] );
+			for( int j = membership.offsets[iElem]; j < membership.offsets[iElem + 1]; ++j ){
+				membership.regions[j] = regionsFound[index++];
+			}
+		}
+	}
+
+}
+
+// Select elements whose volume fraction in the region exceeds the threshold
+void ElementSelector::selectElementsByVolumeFraction( const Region& region, const SelectionParameters& params,
+	const std::vector<int>& positions, std::vector<unsigned char>& isSelected ) const{
+
+	const int numPositions = static_cast<int>( positions.size() );
+
+#pragma omp parallel
+	{
+		Tracer::Event event("worker", "volume fraction");
+#pragma omp for schedule(dynamic, m_chunkSize) nowait
+		for( int i = 0; i < numPositions; ++i ){
+			const int iElem = m_ptrMeshData->getElementOrder( positions[i] );
+			if( calcVolumeFractionInRegion( iElem, region, params.numGaussPoints ) > params.thresholdVolumeFraction ){
+				isSelected[iElem] = 1;
+			}
+		}
+	}
+
+}
+
+// Calculate fraction of volume of a specified element located in the region
+double ElementSelector::calcVolumeFractionInRegion( const int iElem, const Region& region, const int numGaussPoints ) const{
+
+	if( m_ptrMeshData->getMeshType() == MeshData::DHEXA && region.isAxisAlignedCuboid() ){
+		// Overlap volume can be calculated analytically
+		const MeshDataNonConformingHexaElement* const ptrHexaMeshData = static_cast<const MeshDataNonConformingHexaElement*>(m_ptrMeshData);
+		CommonParameters::locationXYZ minCoord = { 0.0, 0.0, 0.0 };
+		CommonParameters::locationXYZ maxCoord = { 0.0, 0.0, 0.0 };
+		region.calcBoundingBox( minCoord, maxCoord );
+		const double volume = ptrHexaMeshData->calcVolume(iElem);
+		const double volumeInRegion = ptrHexaMeshData->calcOverlapVolumeWithCuboid( iElem, minCoord.X, maxCoord.X, minCoord.Y, maxCoord.Y, minCoord.Z, maxCoord.Z );
+		return volume > 0.0 ? volumeInRegion / volume : 0.0;
+	}
+
+	double x[m_maxNumIntegralPoints];
+	double y[m_maxNumIntegralPoints];
+	double z[m_maxNumIntegralPoints];
+	double weights[m_maxNumIntegralPoints];
+	unsigned char flags[m_maxNumIntegralPoints];
+
+	const int numPoints = m_ptrMeshData->calcIntegralPoints( iElem, numGaussPoints, x, y, z, weights );
+	assert( numPoints <= m_maxNumIntegralPoints );
+	region.inRegion( numPoints, x, y, z, flags );
+
+	double volumeInRegion(0.0);
+	double volume(0.0);
+	for( int ip = 0; ip < numPoints; ++ip ){
+		volumeInRegion += flags[ip] * weights[ip];
+		volume += weights[ip];
+	}
+
+	return volume > 0.0 ? volumeInRegion / volume : 0.0;
+
+}
+
+// Add allocated bytes of the arrays to the performance report
+void ElementSelector::addMemoryUsageToReport( const std::string& prefix ) const{
+
+	const long long numElem = static_cast<long long>( m_numElemTotal );
+	PerformanceReport::addMemoryUsage( prefix + ".element_centers", 3 * numElem * static_cast<long long>( sizeof(double) ) );
+	PerformanceReport::addMemoryUsage( prefix + ".positions_of_elements", numElem * static_cast<long long>( sizeof(int) ) );
+
+}
+
+// Determine whether a specified resistivity block can be selected
+bool ElementSelector::isEligibleBlock( const ResistivityBlock& resistivityBlock, const int iBlk, const double resistivityMin, const double resistivityMax ) const{
+
+	if( resistivityBlock.isFixedResistivityValue(iBlk) ){
+		return false;
+	}
+	const double resistivity = resistivityBlock.getResistivityValueFromBlockIndex(iBlk);
+	return resistivity >= resistivityMin && resistivity <= resistivityMax;
+
+}
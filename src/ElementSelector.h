@@ -0,0 +1,164 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#ifndef DBLDEF_ELEMENT_SELECTOR
+#define DBLDEF_ELEMENT_SELECTOR
+
+#include <set>
+#include <vector>
+#include "MeshData.h"
+#include "ResistivityBlock.h"
+#include "Region.h"
+#include "RegionIndex.h"
+
+class Checkerboard;
+
+// Class selecting elements whose resistivity values are changed
+class ElementSelector{
+
+public:
+
+	enum SelectionMode{
+		CENTER_OF_ELEMENT = 0,
+		VOLUME_FRACTION,
+	};
+
+	struct SelectionParameters{
+		// Criterion of the selection
+		int selectionMode;
+		// Number of Gauss points along each direction used for volume fraction
+		int numGaussPoints;
+		// Elements whose volume fraction in the region exceeds this value are selected
+		double thresholdVolumeFraction;
+		// Minimum resistivity of the elements to be selected
+		double resistivityMin;
+		// Maximum resistivity of the elements to be selected
+		double resistivityMax;
+	};
+
+	// Resistivity blocks and elements which can be selected for a resistivity range
+	// [note] : This depends only on the resistivity block model and the range, not on the region.
+	struct Eligibility{
+		// Minimum resistivity of the elements to be selected
+		double resistivityMin;
+		// Maximum resistivity of the elements to be selected
+		double resistivityMax;
+		// Array of the resistivity blocks which can be selected
+		std::vector<int> blocks;
+		// Array of positions in the processing order of the elements which can be selected
+		std::vector<int> positions;
+	};
+
+	// Constructer
+	explicit ElementSelector( const MeshData* const ptrMeshData );
+
+	// Constructer with coordinates of element centers in the processing order calculated beforehand
+	// [note] : The arrays are not copied nor deleted. The centers are calculated if NULL is given.
+	ElementSelector( const MeshData* const ptrMeshData, const double* const xCenter, const double* const yCenter, const double* const zCenter );
+
+	// Destructer
+	~ElementSelector();
+
+	// Calculate resistivity blocks and elements which can be selected
+	void calcEligibility( const ResistivityBlock& resistivityBlock, const double resistivityMin, const double resistivityMax,
+		Eligibility& eligibility ) const;
+
+	// Select elements located in the region
+	void selectElements( const ResistivityBlock& resistivityBlock, const Region& region,
+		const SelectionParameters& params, std::set<int>& elementsSelected ) const;
+
+	// Select elements located in the region with precomputed eligibility
+	void selectElements( const ResistivityBlock& resistivityBlock, const Region& region,
+		const SelectionParameters& params, const Eligibility& eligibility, std::set<int>& elementsSelected ) const;
+
+	// Select elements located in the region by the serial reference implementation
+	// [note] : All the elements are tested one by one in the order of the element IDs without the bounding boxes of the blocks
+	//          nor the coordinates of element centers calculated beforehand. This is slow and is used only for the verification.
+	//          Volume fractions are calculated by calcVolumeFractionInRegion as in the optimized implementation.
+	void selectElementsReference( const ResistivityBlock& resistivityBlock, const Region& region,
+		const SelectionParameters& params, std::set<int>& elementsSelected ) const;
+
+	// Select elements whose centers are located in each type of the cells of a checkerboard
+	void selectElementsByCheckerboard( const Checkerboard& checkerboard, const Eligibility& eligibility,
+		std::set<int>& elementsSelectedType0, std::set<int>& elementsSelectedType1 ) const;
+
+	// Calculate membership of the elements whose centers are located in the indexed regions
+	// [note] : Only the elements which can be selected have nonzero rows
+	void calcRegionMembership( const RegionIndex& regionIndex, const Eligibility& eligibility, RegionIndex::Membership& membership ) const;
+
+	// Calculate fraction of volume of a specified element located in the region
+	double calcVolumeFractionInRegion( const int iElem, const Region& region, const int numGaussPoints ) const;
+
+	// Add allocated bytes of the arrays to the performance report
+	// [note] : The arrays of element centers attached from shared memory are reported as well
+	void addMemoryUsageToReport( const std::string& prefix ) const;
+
+private:
+
+	// Copy constructer
+	ElementSelector(const ElementSelector& rhs);
+
+	// Copy assignment operator
+	ElementSelector& operator=(const ElementSelector& rhs);
+
+	// Number of elements processed at once
+	static const int m_chunkSize = 256;
+
+	// Maximum number of integral points of an element
+	static const int m_maxNumIntegralPoints = 27;
+
+	// Pointer to the mesh data
+	const MeshData* m_ptrMeshData;
+
+	// Total number of elements
+	int m_numElemTotal;
+
+	// Arrays of coordinates of element centers in the processing order
+	const double* m_xCenter;
+	const double* m_yCenter;
+	const double* m_zCenter;
+
+	// Flag specifing whether the arrays of element centers are owned by this object
+	bool m_ownsCenters;
+
+	// Array of positions of each element in the processing order
+	int* m_positionOfElement;
+
+	// Calculate coordinates of element centers in the processing order
+	void calcCentersOfElements();
+
+	// Determine whether a specified resistivity block can be selected
+	bool isEligibleBlock( const ResistivityBlock& resistivityBlock, const int iBlk, const double resistivityMin, const double resistivityMax ) const;
+
+	// Select elements whose centers are located in the region
+	// [note] : Only the elements at the specified positions in the processing order are tested
+	void selectElementsByCenter( const Region& region, const std::vector<int>& positions, std::vector<unsigned char>& isSelected ) const;
+
+	// Select elements whose volume fraction in the region exceeds the threshold
+	// [note] : Only the elements at the specified positions in the processing order are tested
+	void selectElementsByVolumeFraction( const Region& region, const SelectionParameters& params,
+		const std::vector<int>& positions, std::vector<unsigned char>& isSelected ) const;
+
+};
+
+#endif
@@ -29,9 +29,14 @@
 #include <math.h>
 #include <map>
 #include <assert.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
 
 #include "MeshData.h"
 #include "CommonParameters.h"
+#include "Util.h"
+#include "PerformanceReport.h"
 
 // Constructer
 MeshData::MeshData():
@@ -45,7 +50,9 @@ MeshData::MeshData():
 	m_yCoordinatesOfNodes(NULL),
 	m_zCoordinatesOfNodes(NULL),
 	m_neighborElements(NULL),
-	m_nodesOfElements(NULL)
+	m_nodesOfElements(NULL),
+	m_elementOrder(NULL),
+	m_ownsArrays(true)
 {
 
 	for ( int i = 0; i < 6; ++i ){
@@ -61,6 +68,15 @@ MeshData::MeshData():
 // Destructer
 MeshData::~MeshData(){
 
+	if( !m_ownsArrays ){
+		// Arrays attached from others are not deleted
+		m_xCoordinatesOfNodes = NULL;
+		m_yCoordinatesOfNodes = NULL;
+		m_zCoordinatesOfNodes = NULL;
+		m_nodesOfElements = NULL;
+		m_elementOrder = NULL;
+	}
+
 	if( m_xCoordinatesOfNodes != NULL){
 		delete[] m_xCoordinatesOfNodes;
 		m_xCoordinatesOfNodes = NULL;
@@ -86,6 +102,11 @@ MeshData::~MeshData(){
 		m_nodesOfElements = NULL;
 	}
 
+	if( m_elementOrder != NULL){
+		delete[] m_elementOrder;
+		m_elementOrder = NULL;
+	}
+
 	for ( int i = 0; i < 6; ++i ){
 		if( m_elemBoundaryPlanes[i] != NULL){
 			delete[] m_elemBoundaryPlanes[i];
@@ -315,6 +336,173 @@ CommonParameters::locationXYZ MeshData::getElementCenter( const int iElem ) cons
 	return val;
 }
 
+// Sort elements along space-filling curve and renumber nodes in the order
+void MeshData::reorderBySpaceFillingCurve(){
+
+	PerformanceReport::Timer timer(PerformanceReport::MESH_REORDERING);
+
+	if( m_numElemTotal <= 0 ){
+		return;
+	}
+
+	std::vector<double> xCenter(m_numElemTotal);
+	std::vector<double> yCenter(m_numElemTotal);
+	std::vector<double> zCenter(m_numElemTotal);
+#pragma omp parallel for
+	for( int iElem = 0; iElem < m_numElemTotal; ++iElem ){
+		const CommonParameters::locationXYZ center = getElementCenter(iElem);
+		xCenter[iElem] = center.X;
+		yCenter[iElem] = center.Y;
+		zCenter[iElem] = center.Z;
+	}
+
+	CommonParameters::locationXYZ minCoord = { xCenter[0], yCenter[0], zCenter[0] };
+	CommonParameters::locationXYZ maxCoord = minCoord;
+	for( int iElem = 1; iElem < m_numElemTotal; ++iElem ){
+		minCoord.X = std::min( minCoord.X, xCenter[iElem] );
+		minCoord.Y = std::min( minCoord.Y, yCenter[iElem] );
+		minCoord.Z = std::min( minCoord.Z, zCenter[iElem] );
+		maxCoord.X = std::max( maxCoord.X, xCenter[iElem] );
+		maxCoord.Y = std::max( maxCoord.Y, yCenter[iElem] );
+		maxCoord.Z = std::max( maxCoord.Z, zCenter[iElem] );
+	}
+
+	// Quantize the coordinates of the element centers to 21 bits and calculate Morton codes
+	const double maxInteger = static_cast<double>( ( 1 << 21 ) - 1 );
+	const double xFactor = maxCoord.X - minCoord.X > CommonParameters::EPS ? maxInteger / ( maxCoord.X - minCoord.X ) : 0.0;
+	const double yFactor = maxCoord.Y - minCoord.Y > CommonParameters::EPS ? maxInteger / ( maxCoord.Y - minCoord.Y ) : 0.0;
+	const double zFactor = maxCoord.Z - minCoord.Z > CommonParameters::EPS ? maxInteger / ( maxCoord.Z - minCoord.Z ) : 0.0;
+	std::vector<unsigned long long> mortonCodes(m_numElemTotal);
+#pragma omp parallel for
+	for( int iElem = 0; iElem < m_numElemTotal; ++iElem ){
+		const unsigned int ix = static_cast<unsigned int>( ( xCenter[iElem] - minCoord.X ) * xFactor );
+		const unsigned int iy = static_cast<unsigned int>( ( yCenter[iElem] - minCoord.Y ) * yFactor );
+		const unsigned int iz = static_cast<unsigned int>( ( zCenter[iElem] - minCoord.Z ) * zFactor );
+		mortonCodes[iElem] = calcMortonCode( ix, iy, iz );
+	}
+
+	if( m_elementOrder != NULL ){
+		delete[] m_elementOrder;
+	}
+	m_elementOrder = new int[m_numElemTotal];
+	for( int iElem = 0; iElem < m_numElemTotal; ++iElem ){
+		m_elementOrder[iElem] = iElem;
+	}
+	radixSort( m_numElemTotal, m_elementOrder, &mortonCodes[0] );
+
+	// Renumber nodes in the order in which they are first referred by the sorted elements
+	std::vector<int> newNodeIDs( m_numNodeTotal, -1 );
+	int icount(0);
+	for( int i = 0; i < m_numElemTotal; ++i ){
+		const int iElem = m_elementOrder[i];
+		for( int iNode = 0; iNode < m_numNodeOneElement; ++iNode ){
+			const int nodeID = m_nodesOfElements[ m_numNodeOneElement * iElem + iNode ];
+			if( newNodeIDs[nodeID] < 0 ){
+				newNodeIDs[nodeID] = icount++;
+			}
+		}
+	}
+	for( int iNode = 0; iNode < m_numNodeTotal; ++iNode ){
+		if( newNodeIDs[iNode] < 0 ){
+			// Nodes not belonging to any element are placed at the end
+			newNodeIDs[iNode] = icount++;
+		}
+	}
+	assert( icount == m_numNodeTotal );
+
+	double* coords[3] = { m_xCoordinatesOfNodes, m_yCoordinatesOfNodes, m_zCoordinatesOfNodes };
+	std::vector<double> coordsBuf(m_numNodeTotal);
+	for( int i = 0; i < 3; ++i ){
+#pragma omp parallel for
+		for( int iNode = 0; iNode < m_numNodeTotal; ++iNode ){
+			coordsBuf[ newNodeIDs[iNode] ] = coords[i][iNode];
+		}
+		memcpy( coords[i], &coordsBuf[0], sizeof(double) * m_numNodeTotal );
+	}
+	const long long numNodesOfElements = static_cast<long long>(m_numElemTotal) * m_numNodeOneElement;
+#pragma omp parallel for
+	for( long long i = 0; i < numNodesOfElements; ++i ){
+		m_nodesOfElements[i] = newNodeIDs[ m_nodesOfElements[i] ];
+	}
+
+}
+
+// Get ID of the element at the specified position in the processing order
+int MeshData::getElementOrder( const int num ) const{
+	assert( num >= 0 );
+	assert( num < m_numElemTotal );
+
+	if( m_elementOrder == NULL ){
+		return num;
+	}
+	return m_elementOrder[num];
+}
+
+// Get total number of nodes
+int MeshData::getNumNodeTotal() const{
+	return m_numNodeTotal;
+}
+
+// Get number of nodes belonging to one element
+int MeshData::getNumNodeOneElement() const{
+	return m_numNodeOneElement;
+}
+
+// Get arrays of coordinates of nodes, nodes composing each element and element order
+void MeshData::getArrays( const double*& xCoordinatesOfNodes, const double*& yCoordinatesOfNodes, const double*& zCoordinatesOfNodes,
+	const int*& nodesOfElements, const int*& elementOrder ) const{
+	xCoordinatesOfNodes = m_xCoordinatesOfNodes;
+	yCoordinatesOfNodes = m_yCoordinatesOfNodes;
+	zCoordinatesOfNodes = m_zCoordinatesOfNodes;
+	nodesOfElements = m_nodesOfElements;
+	elementOrder = m_elementOrder;
+}
+
+// Add allocated bytes of the arrays to the performance report
+void MeshData::addMemoryUsageToReport( const std::string& prefix ) const{
+
+	const long long numElem = static_cast<long long>( m_numElemTotal );
+	const long long numNode = static_cast<long long>( m_numNodeTotal );
+
+	PerformanceReport::addMemoryUsage( prefix + ".node_coordinates", m_xCoordinatesOfNodes == NULL ? 0 : 3 * numNode * static_cast<long long>( sizeof(double) ) );
+	PerformanceReport::addMemoryUsage( prefix + ".element_connectivity", m_nodesOfElements == NULL ? 0 : numElem * m_numNodeOneElement * static_cast<long long>( sizeof(int) ) );
+	if( m_neighborElements != NULL ){
+		PerformanceReport::addMemoryUsage( prefix + ".neighbor_elements", numElem * m_numNeighborElement * static_cast<long long>( sizeof(int) ) );
+	}
+	PerformanceReport::addMemoryUsage( prefix + ".element_order", m_elementOrder == NULL ? 0 : numElem * static_cast<long long>( sizeof(int) ) );
+
+	long long bytes(0);
+	for( int iPlane = 0; iPlane < 6; ++iPlane ){
+		if( m_elemBoundaryPlanes[iPlane] != NULL ){
+			bytes += static_cast<long long>( m_numElemOnBoundaryPlanes[iPlane] ) * static_cast<long long>( sizeof(int) );
+		}
+	}
+	PerformanceReport::addMemoryUsage( prefix + ".boundary_plane_elements", bytes );
+
+}
+
+// Use arrays owned by others instead of inputting mesh data
+void MeshData::attachArrays( const int numElemTotal, const int numNodeTotal,
+	const double* const xCoordinatesOfNodes, const double* const yCoordinatesOfNodes, const double* const zCoordinatesOfNodes,
+	const int* const nodesOfElements, const int* const elementOrder ){
+
+	if( m_xCoordinatesOfNodes != NULL || m_nodesOfElements != NULL ){
+		std::cerr << "Error : Arrays cannot be attached to the mesh data which has been input." << std::endl;
+		exit(1);
+	}
+
+	m_ownsArrays = false;
+	m_numElemTotal = numElemTotal;
+	m_numNodeTotal = numNodeTotal;
+	// The arrays are only read through this object
+	m_xCoordinatesOfNodes = const_cast<double*>( xCoordinatesOfNodes );
+	m_yCoordinatesOfNodes = const_cast<double*>( yCoordinatesOfNodes );
+	m_zCoordinatesOfNodes = const_cast<double*>( zCoordinatesOfNodes );
+	m_nodesOfElements = const_cast<int*>( nodesOfElements );
+	m_elementOrder = const_cast<int*>( elementOrder );
+
+}
+
 // Calculate distanceof two points
 double MeshData::calcDistance( const CommonParameters::locationXY& point0,  const CommonParameters::locationXY& point1 ) const{
 
@@ -25,6 +25,7 @@
 #define DBLDEF_MESHDATA
 
 #include <vector>
+#include <string>
 #include "CommonParameters.h"
 
 // Class of FEM mesh for brick element
@@ -67,6 +68,9 @@ public:
 	// Input mesh data from "mesh.dat"
 	virtual void inputMeshData() = 0;
 
+	// Get type of mesh
+	virtual int getMeshType() const = 0;
+
 	// Get tolal number of elements
 	int getNumElemTotal() const;
 
@@ -112,6 +116,38 @@ public:
 	// Calculate coordinate of the center of a specified element
 	CommonParameters::locationXYZ getElementCenter( const int iElem ) const;
 
+	// Calculate coordinates and weights of integral points of a specified element
+	// [note] : The number of points is numGauss^3 and the weights sum up to the volume of the element
+	virtual int calcIntegralPoints( const int iElem, const int numGauss, double* x, double* y, double* z, double* weights ) const = 0;
+
+	// Sort elements along space-filling curve and renumber nodes in the order
+	// [note] : Element IDs are not changed. Nodes are renumbered only internally.
+	void reorderBySpaceFillingCurve();
+
+	// Get ID of the element at the specified position in the processing order
+	int getElementOrder( const int num ) const;
+
+	// Get total number of nodes
+	int getNumNodeTotal() const;
+
+	// Get number of nodes belonging to one element
+	int getNumNodeOneElement() const;
+
+	// Get arrays of coordinates of nodes, nodes composing each element and element order
+	// [note] : The array of element order is NULL if elements have not been sorted
+	void getArrays( const double*& xCoordinatesOfNodes, const double*& yCoordinatesOfNodes, const double*& zCoordinatesOfNodes,
+		const int*& nodesOfElements, const int*& elementOrder ) const;
+
+	// Add allocated bytes of the arrays to the performance report
+	// [note] : The arrays attached from shared memory are reported as well although they are shared by the processes
+	virtual void addMemoryUsageToReport( const std::string& prefix ) const;
+
+	// Use arrays owned by others instead of inputting mesh data
+	// [note] : The arrays are not copied nor deleted. Only the functions referring to the nodes and the elements are available.
+	void attachArrays( const int numElemTotal, const int numNodeTotal,
+		const double* const xCoordinatesOfNodes, const double* const yCoordinatesOfNodes, const double* const zCoordinatesOfNodes,
+		const int* const nodesOfElements, const int* const elementOrder );
+
 protected:
 
 	// Copy constructer
@@ -156,6 +192,12 @@ protected:
 	// Array of nodes composing each element
 	int* m_nodesOfElements;
 
+	// Array of element IDs sorted along space-filling curve
+	int* m_elementOrder;
+
+	// Flag specifing whether the arrays of nodes and elements are owned by this object
+	bool m_ownsArrays;
+
 	// Array of elements belonging to the boundary planes
 	//   m_elemBoundaryPlane[0] : Y-Z Plane ( Minus Side )
 	//   m_elemBoundaryPlane[1] : Y-Z Plane ( Plus Side  )
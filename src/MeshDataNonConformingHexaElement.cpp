@@ -32,8 +32,11 @@
 #include <stdio.h>
 #include <string.h>
 #include <assert.h>
+#include <algorithm>
 
 #include "MeshDataNonConformingHexaElement.h"
+#include "PerformanceReport.h"
+#include "ProgressReporter.h"
 #include "CommonParameters.h"
 #include "ResistivityBlock.h"
 #include "Util.h"
@@ -253,12 +256,16 @@ MeshDataNonConformingHexaElement& MeshDataNonConformingHexaElement::operator=(co
 // Input mesh data from "mesh.dat"
 void MeshDataNonConformingHexaElement::inputMeshData(){
 
+	PerformanceReport::Timer timer(PerformanceReport::MESH_INPUT);
+
 	std::ifstream inFile( "mesh.dat", std::ios::in );
 	if( inFile.fail() )
 	{
 		std::cerr << "File open error : mesh.dat !!" << std::endl;
 		exit(1);
 	}
+	PerformanceReport::addSizeOfFile(PerformanceReport::BYTES_OF_INPUT_FILES, "mesh.dat");
+	ProgressReporter progress("mesh.dat");
 
 	std::string sbuf;
 	inFile >> sbuf;
@@ -292,6 +299,7 @@ void MeshDataNonConformingHexaElement::inputMeshData(){
 	m_zCoordinatesOfNodes = new double[m_numNodeTotal];
 
 	for( int iNode = 0; iNode < m_numNodeTotal; ++iNode ){
+		progress.update( inFile, "nodes", iNode );
 		int idum(0);
 		inFile >> idum >> m_xCoordinatesOfNodes[iNode] >> m_yCoordinatesOfNodes[iNode] >> m_zCoordinatesOfNodes[iNode];
 		assert( idum == iNode ); 
@@ -316,6 +324,7 @@ void MeshDataNonConformingHexaElement::inputMeshData(){
 	m_neighborElementsForNonConformingHexa = new std::vector<int>[ m_numElemTotal * 6 ];
 
 	for( int iElem = 0; iElem < m_numElemTotal; ++iElem ){
+		progress.update( inFile, "elements", iElem );
 		int idum(0);
 		inFile >> idum;
 		assert( idum == iElem ); 
@@ -406,6 +415,46 @@ void MeshDataNonConformingHexaElement::inputMeshData(){
 	}
 
 	inFile.close();
+	progress.finish();
+
+}
+
+// Get type of mesh
+int MeshDataNonConformingHexaElement::getMeshType() const{
+	return MeshData::DHEXA;
+}
+
+// Add allocated bytes of the arrays to the performance report
+void MeshDataNonConformingHexaElement::addMemoryUsageToReport( const std::string& prefix ) const{
+
+	MeshData::addMemoryUsageToReport(prefix);
+
+	// Each element-face has its own vector whose array is allocated separately
+	if( m_neighborElementsForNonConformingHexa != NULL ){
+		const long long numFaces = 6 * static_cast<long long>( m_numElemTotal );
+		long long bytes = numFaces * static_cast<long long>( sizeof(std::vector<int>) );
+		for( long long i = 0; i < numFaces; ++i ){
+			bytes += PerformanceReport::calcHeapBlockSize( static_cast<long long>( m_neighborElementsForNonConformingHexa[i].capacity() * sizeof(int) ) );
+		}
+		PerformanceReport::addMemoryUsage( prefix + ".neighbor_elements", bytes );
+	}
+
+	long long bytes(0);
+	for( int iPlane = 0; iPlane < 6; ++iPlane ){
+		if( m_facesOfElementsBoundaryPlanes[iPlane] != NULL ){
+			bytes += static_cast<long long>( m_numElemOnBoundaryPlanes[iPlane] ) * static_cast<long long>( sizeof(int) );
+		}
+	}
+	PerformanceReport::addMemoryUsage( prefix + ".boundary_plane_faces", bytes );
+
+	bytes = 0;
+	if( m_elemOnLandSurface != NULL ){
+		bytes += static_cast<long long>( m_numElemOnLandSurface ) * static_cast<long long>( sizeof(int) );
+	}
+	if( m_faceLandSurface != NULL ){
+		bytes += static_cast<long long>( m_numElemOnLandSurface ) * static_cast<long long>( sizeof(int) );
+	}
+	PerformanceReport::addMemoryUsage( prefix + ".land_surface", bytes );
 
 }
 
@@ -770,6 +819,107 @@ double MeshDataNonConformingHexaElement::calcAreaOfFaceAtBottomOfMesh( const int
 	return calcAreaOfFace(elemID, iFace);
 }
 
+// Calculate volume of the part of a specified element overlapping with an axis-aligned cuboid
+// Because side faces are parallel to Z-X or Y-Z plane, the overlap is the integral over the
+// horizontal intersection rectangle of the length of [ zLower(x,y), zUpper(x,y) ] within [ zMin, zMax ].
+// The length equals R(zUpper-zMin) - R(zUpper-zMax) - R(zLower-zMin) + R(zLower-zMax) with R(f) = max(f,0),
+// and each term is the positive part of a bilinear function, which is integrated analytically.
+double MeshDataNonConformingHexaElement::calcOverlapVolumeWithCuboid( const int iElem, const double xMin, const double xMax,
+	const double yMin, const double yMax, const double zMin, const double zMax ) const{
+
+	assert( iElem >= 0 );
+	assert( iElem < m_numElemTotal );
+
+	const int nodeID0 = getNodesOfElements(iElem, 0);
+	const int nodeID2 = getNodesOfElements(iElem, 2);
+	const double xElemMin = std::min( getXCoordinatesOfNodes(nodeID0), getXCoordinatesOfNodes(nodeID2) );
+	const double xElemMax = std::max( getXCoordinatesOfNodes(nodeID0), getXCoordinatesOfNodes(nodeID2) );
+	const double yElemMin = std::min( getYCoordinatesOfNodes(nodeID0), getYCoordinatesOfNodes(nodeID2) );
+	const double yElemMax = std::max( getYCoordinatesOfNodes(nodeID0), getYCoordinatesOfNodes(nodeID2) );
+
+	// Horizontal intersection rectangle
+	const double x0 = std::max( xMin, xElemMin );
+	const double x1 = std::min( xMax, xElemMax );
+	const double y0 = std::max( yMin, yElemMin );
+	const double y1 = std::min( yMax, yElemMax );
+	if( x0 >= x1 || y0 >= y1 || zMin >= zMax ){
+		return 0.0;
+	}
+
+	// Z coordinates of the top and bottom faces at the corners of the intersection rectangle
+	const double xCorner[4] = { x0, x1, x0, x1 };
+	const double yCorner[4] = { y0, y0, y1, y1 };
+	double zLower[4] = { 0.0, 0.0, 0.0, 0.0 };
+	double zUpper[4] = { 0.0, 0.0, 0.0, 0.0 };
+	for( int i = 0; i < 4; ++i ){
+		double xi(0.0);
+		double eta(0.0);
+		calcHorizontalLocalCoordinates( iElem, xCorner[i], yCorner[i], xi, eta );
+		zLower[i] = calcZCoordOfPointOnFace( iElem, 4, xi, eta );
+		zUpper[i] = calcZCoordOfPointOnFace( iElem, 5, xi, eta );
+	}
+	if( zLower[0] + zLower[1] + zLower[2] + zLower[3] > zUpper[0] + zUpper[1] + zUpper[2] + zUpper[3] ){
+		for( int i = 0; i < 4; ++i ){
+			std::swap( zLower[i], zUpper[i] );
+		}
+	}
+
+	const double lengthIntegral =
+		  calcIntegralOfPositivePartOfBilinearFunction( zUpper[0] - zMin, zUpper[1] - zMin, zUpper[2] - zMin, zUpper[3] - zMin )
+		- calcIntegralOfPositivePartOfBilinearFunction( zUpper[0] - zMax, zUpper[1] - zMax, zUpper[2] - zMax, zUpper[3] - zMax )
+		- calcIntegralOfPositivePartOfBilinearFunction( zLower[0] - zMin, zLower[1] - zMin, zLower[2] - zMin, zLower[3] - zMin )
+		+ calcIntegralOfPositivePartOfBilinearFunction( zLower[0] - zMax, zLower[1] - zMax, zLower[2] - zMax, zLower[3] - zMax );
+
+	return std::max( lengthIntegral, 0.0 ) * ( x1 - x0 ) * ( y1 - y0 );
+
+}
+
+// Calculate coordinates and weights of integral points of a specified element
+int MeshDataNonConformingHexaElement::calcIntegralPoints( const int iElem, const int numGauss, double* x, double* y, double* z, double* weights ) const{
+
+	assert( iElem >= 0 );
+	assert( iElem < m_numElemTotal );
+
+	const double* abscissas = NULL;
+	const double* weights1D = NULL;
+	getGaussQuadrature( numGauss, abscissas, weights1D );
+
+	double xCoord[8] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+	double yCoord[8] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+	double zCoord[8] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+	for( int i = 0; i < 8; ++i ){
+		const int nodeID = getNodesOfElements(iElem, i);
+		xCoord[i] = getXCoordinatesOfNodes(nodeID);
+		yCoord[i] = getYCoordinatesOfNodes(nodeID);
+		zCoord[i] = getZCoordinatesOfNodes(nodeID);
+	}
+
+	int ip(0);
+	for( int i = 0; i < numGauss; ++i ){
+		const double xi = abscissas[i];
+		for( int j = 0; j < numGauss; ++j ){
+			const double eta = abscissas[j];
+			for( int k = 0; k < numGauss; ++k ){
+				const double zeta = abscissas[k];
+				x[ip] = 0.0;
+				y[ip] = 0.0;
+				z[ip] = 0.0;
+				for( int iNode = 0; iNode < 8; ++iNode ){
+					const double shapeFunction = 0.125 * ( 1.0 + xi * m_xiAtNode[iNode] ) * ( 1.0 + eta * m_etaAtNode[iNode] ) * ( 1.0 + zeta * m_zetaAtNode[iNode] );
+					x[ip] += shapeFunction * xCoord[iNode];
+					y[ip] += shapeFunction * yCoord[iNode];
+					z[ip] += shapeFunction * zCoord[iNode];
+				}
+				weights[ip] = weights1D[i] * weights1D[j] * weights1D[k] * fabs( calcDeterminantOfJacobianMatrix( iElem, xi, eta, zeta ) );
+				++ip;
+			}
+		}
+	}
+
+	return ip;
+
+}
+
 // Check whether side element-faces are parallel to Z-X or Y-Z plane
 void MeshDataNonConformingHexaElement::checkWhetherSideFaceIsParallelToZXOrYZPlane() const{
 
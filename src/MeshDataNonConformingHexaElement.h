@@ -41,6 +41,12 @@ public:
 	// Input mesh data from "mesh.dat"
 	virtual void inputMeshData();
 
+	// Get type of mesh
+	virtual int getMeshType() const;
+
+	// Add allocated bytes of the arrays to the performance report
+	virtual void addMemoryUsageToReport( const std::string& prefix ) const;
+
 	// Get ID of a neighbor element
 	int getIDOfNeighborElement( const int iElem, const int iFace, const int num ) const;
 
@@ -116,6 +122,13 @@ public:
 	// Calculate area of face at bottom of mesh
 	double calcAreaOfFaceAtBottomOfMesh( const int iElem ) const;
 
+	// Calculate volume of the part of a specified element overlapping with an axis-aligned cuboid
+	double calcOverlapVolumeWithCuboid( const int iElem, const double xMin, const double xMax,
+		const double yMin, const double yMax, const double zMin, const double zMax ) const;
+
+	// Calculate coordinates and weights of integral points of a specified element
+	virtual int calcIntegralPoints( const int iElem, const int numGauss, double* x, double* y, double* z, double* weights ) const;
+
 private:
 
 	// Copy constructer
@@ -33,6 +33,8 @@
 
 #include "Util.h"
 #include "MeshDataTetraElement.h"
+#include "PerformanceReport.h"
+#include "ProgressReporter.h"
 #include "CommonParameters.h"
 
 const double MeshDataTetraElement::m_eps = 1.0e-12;
@@ -132,12 +134,16 @@ MeshDataTetraElement::~MeshDataTetraElement(){
 // Input mesh data from "mesh.dat"
 void MeshDataTetraElement::inputMeshData(){
 
+	PerformanceReport::Timer timer(PerformanceReport::MESH_INPUT);
+
 	std::ifstream inFile( "mesh.dat", std::ios::in );
 	if( inFile.fail() )
 	{
 		std::cerr << "File open error : mesh.dat !!" << std::endl;
 		exit(1);
 	}
+	PerformanceReport::addSizeOfFile(PerformanceReport::BYTES_OF_INPUT_FILES, "mesh.dat");
+	ProgressReporter progress("mesh.dat");
 
 	std::string sbuf;
 	inFile >> sbuf;
@@ -174,6 +180,7 @@ void MeshDataTetraElement::inputMeshData(){
 
 	for( int iNode = 0; iNode < m_numNodeTotal; ++iNode ){
 
+		progress.update( inFile, "nodes", iNode );
 		int idum(0);
 		inFile >> idum >> m_xCoordinatesOfNodes[iNode] >> m_yCoordinatesOfNodes[iNode] >> m_zCoordinatesOfNodes[iNode];
 
@@ -203,6 +210,7 @@ void MeshDataTetraElement::inputMeshData(){
 
 	for( int iElem = 0; iElem < m_numElemTotal; ++iElem ){
 
+		progress.update( inFile, "elements", iElem );
 		int idum(0);
 		inFile >> idum;
 
@@ -336,6 +344,36 @@ void MeshDataTetraElement::inputMeshData(){
 	}
 
 	inFile.close();
+	progress.finish();
+
+}
+
+// Get type of mesh
+int MeshDataTetraElement::getMeshType() const{
+	return MeshData::TETRA;
+}
+
+// Add allocated bytes of the arrays to the performance report
+void MeshDataTetraElement::addMemoryUsageToReport( const std::string& prefix ) const{
+
+	MeshData::addMemoryUsageToReport(prefix);
+
+	long long bytes(0);
+	for( int iPlane = 0; iPlane < 6; ++iPlane ){
+		if( m_facesOfElementsBoundaryPlanes[iPlane] != NULL ){
+			bytes += static_cast<long long>( m_numElemOnBoundaryPlanes[iPlane] ) * static_cast<long long>( sizeof(int) );
+		}
+	}
+	PerformanceReport::addMemoryUsage( prefix + ".boundary_plane_faces", bytes );
+
+	bytes = 0;
+	if( m_elemOnLandSurface != NULL ){
+		bytes += static_cast<long long>( m_numElemOnLandSurface ) * static_cast<long long>( sizeof(int) );
+	}
+	if( m_faceLandSurface != NULL ){
+		bytes += static_cast<long long>( m_numElemOnLandSurface ) * static_cast<long long>( sizeof(int) );
+	}
+	PerformanceReport::addMemoryUsage( prefix + ".land_surface", bytes );
 
 }
 
@@ -1019,6 +1057,53 @@ double MeshDataTetraElement::calcVolume( const int elemID ) const{
 	return calcVolume( nodeCoord[0], nodeCoord[1], nodeCoord[2], nodeCoord[3] );
 }
 
+// Calculate coordinates and weights of integral points of a specified element
+// The unit cube is mapped to the tetrahedron by collapsed coordinates (u, v, w) whose
+// volume coordinates are ( 1-u-v(1-u)-w(1-u)(1-v), u, v(1-u), w(1-u)(1-v) ).
+int MeshDataTetraElement::calcIntegralPoints( const int iElem, const int numGauss, double* x, double* y, double* z, double* weights ) const{
+
+	assert( iElem >= 0 );
+	assert( iElem < m_numElemTotal );
+
+	const double* abscissas = NULL;
+	const double* weights1D = NULL;
+	getGaussQuadrature( numGauss, abscissas, weights1D );
+
+	CommonParameters::locationXYZ nodeCoord[4];
+	for( int i = 0; i < 4; ++i ){
+		const int nodeID = getNodesOfElements( iElem, i ); 
+		nodeCoord[i].X = getXCoordinatesOfNodes( nodeID );
+		nodeCoord[i].Y = getYCoordinatesOfNodes( nodeID );
+		nodeCoord[i].Z = getZCoordinatesOfNodes( nodeID );
+	}
+	// Jacobian of the mapping from the unit tetrahedron is six times the volume
+	const double factor = 6.0 * fabs( calcVolume( nodeCoord[0], nodeCoord[1], nodeCoord[2], nodeCoord[3] ) ) * 0.125;
+
+	int ip(0);
+	for( int i = 0; i < numGauss; ++i ){
+		const double u = 0.5 * ( 1.0 + abscissas[i] );
+		for( int j = 0; j < numGauss; ++j ){
+			const double v = 0.5 * ( 1.0 + abscissas[j] );
+			for( int k = 0; k < numGauss; ++k ){
+				const double w = 0.5 * ( 1.0 + abscissas[k] );
+				CommonParameters::VolumeCoords coords;
+				coords.coord1 = u;
+				coords.coord2 = v * ( 1.0 - u );
+				coords.coord3 = w * ( 1.0 - u ) * ( 1.0 - v );
+				coords.coord0 = 1.0 - coords.coord1 - coords.coord2 - coords.coord3;
+				x[ip] = coords.coord0 * nodeCoord[0].X + coords.coord1 * nodeCoord[1].X + coords.coord2 * nodeCoord[2].X + coords.coord3 * nodeCoord[3].X;
+				y[ip] = coords.coord0 * nodeCoord[0].Y + coords.coord1 * nodeCoord[1].Y + coords.coord2 * nodeCoord[2].Y + coords.coord3 * nodeCoord[3].Y;
+				z[ip] = coords.coord0 * nodeCoord[0].Z + coords.coord1 * nodeCoord[1].Z + coords.coord2 * nodeCoord[2].Z + coords.coord3 * nodeCoord[3].Z;
+				weights[ip] = weights1D[i] * weights1D[j] * weights1D[k] * ( 1.0 - u ) * ( 1.0 - u ) * ( 1.0 - v ) * factor;
+				++ip;
+			}
+		}
+	}
+
+	return ip;
+
+}
+
 // Calculate volume coordinates of point
 void MeshDataTetraElement::calcVolumeCoordsOfPoint( const int elemID, const CommonParameters::locationXYZ& pointCoord, CommonParameters::VolumeCoords& coords ) const{
 
@@ -42,6 +42,12 @@ public:
 	// Input mesh data from "mesh.dat"
 	virtual void inputMeshData();
 
+	// Get type of mesh
+	virtual int getMeshType() const;
+
+	// Add allocated bytes of the arrays to the performance report
+	virtual void addMemoryUsageToReport( const std::string& prefix ) const;
+
 	// Get local face ID of elements belonging to the boundary planes
 	int getFaceIDLocalFromElementBoundaryPlanes( const int iPlane, const int iElem ) const;
 
@@ -100,6 +106,9 @@ public:
 	// Calculate volume of tetrahedral element
 	double calcVolume( const int iElem ) const;
 
+	// Calculate coordinates and weights of integral points of a specified element
+	virtual int calcIntegralPoints( const int iElem, const int numGauss, double* x, double* y, double* z, double* weights ) const;
+
 private:
 
 	// Copy constructer
@@ -0,0 +1,173 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#include <iostream>
+#include <set>
+#include <vector>
+#include <stdlib.h>
+
+#include "MultiRegion.h"
+#include "RegionIndex.h"
+#include "ResistivityBlockOverlay.h"
+
+// Constructer
+MultiRegion::MultiRegion():
+	m_resistivityMin(0.1),
+	m_resistivityMax(1.0e4),
+	m_numRegions(0),
+	m_regions(NULL),
+	m_priorities(NULL),
+	m_modifiedResistivity(NULL),
+	m_modifiedMinResistivity(NULL),
+	m_modifiedMaxResistivity(NULL)
+{
+}
+
+// Destructer
+MultiRegion::~MultiRegion(){
+
+	if( m_regions != NULL ){
+		delete[] m_regions;
+		m_regions = NULL;
+	}
+
+	if( m_priorities != NULL ){
+		delete[] m_priorities;
+		m_priorities = NULL;
+	}
+
+	if( m_modifiedResistivity != NULL ){
+		delete[] m_modifiedResistivity;
+		m_modifiedResistivity = NULL;
+	}
+
+	if( m_modifiedMinResistivity != NULL ){
+		delete[] m_modifiedMinResistivity;
+		m_modifiedMinResistivity = NULL;
+	}
+
+	if( m_modifiedMaxResistivity != NULL ){
+		delete[] m_modifiedMaxResistivity;
+		m_modifiedMaxResistivity = NULL;
+	}
+
+}
+
+// Copy constructer
+MultiRegion::MultiRegion(const MultiRegion& rhs){
+	std::cerr << "Error : Copy constructer of the class MultiRegion is not implemented." << std::endl;
+	exit(1);
+}
+
+// Assignment operator
+MultiRegion& MultiRegion::operator=(const MultiRegion& rhs){
+	std::cerr << "Error : Assignment operator of the class MultiRegion is not implemented." << std::endl;
+	exit(1);
+}
+
+// Read parameters of the regions from input stream
+void MultiRegion::readParameters( std::istream& ifs ){
+
+	ifs >> m_resistivityMin;
+	std::cout << "Minimum resistivity for selecting parameter cells [Ohm-m] :  " << m_resistivityMin << std::endl;
+	ifs >> m_resistivityMax;
+	std::cout << "Maximum resistivity for selecting parameter cells [Ohm-m] :  " << m_resistivityMax << std::endl;
+
+	ifs >> m_numRegions;
+	std::cout << "Number of regions : " << m_numRegions << std::endl;
+	if( m_numRegions < 1 ){
+		std::cerr << "Number of regions must be positive !!" << std::endl;
+		exit(1);
+	}
+
+	m_regions = new Region[m_numRegions];
+	m_priorities = new int[m_numRegions];
+	m_modifiedResistivity = new double[m_numRegions];
+	m_modifiedMinResistivity = new double[m_numRegions];
+	m_modifiedMaxResistivity = new double[m_numRegions];
+	for( int iRegion = 0; iRegion < m_numRegions; ++iRegion ){
+		std::cout << "Region " << iRegion << std::endl;
+		ifs >> m_priorities[iRegion];
+		std::cout << "Priority : " << m_priorities[iRegion] << std::endl;
+		m_regions[iRegion].readParameters(ifs);
+		ifs >> m_modifiedResistivity[iRegion];
+		std::cout << "Modified resistivity [Ohm-m] :  " << m_modifiedResistivity[iRegion] << std::endl;
+		ifs >> m_modifiedMinResistivity[iRegion];
+		std::cout << "Modified minimum resistivity [Ohm-m] :  " << m_modifiedMinResistivity[iRegion] << std::endl;
+		ifs >> m_modifiedMaxResistivity[iRegion];
+		std::cout << "Modified maximum resistivity [Ohm-m] :  " << m_modifiedMaxResistivity[iRegion] << std::endl;
+	}
+
+}
+
+// Get minimum resistivity of the elements to be changed
+double MultiRegion::getResistivityMin() const{
+	return m_resistivityMin;
+}
+
+// Get maximum resistivity of the elements to be changed
+double MultiRegion::getResistivityMax() const{
+	return m_resistivityMax;
+}
+
+// Change resistivity of the elements in the regions and output the modified model
+void MultiRegion::execute( const bool isTetra, const MeshData* const ptrMeshData, const ResistivityBlock& resistivityBlock,
+	const ElementSelector& selector, const ElementSelector::Eligibility& eligibility, const int iterNum, std::ostream& ofsLog ) const{
+
+	const RegionIndex regionIndex( m_numRegions, m_regions );
+	RegionIndex::Membership membership;
+	selector.calcRegionMembership( regionIndex, eligibility, membership );
+
+	// Each element is assigned to the region of the highest priority
+	std::vector< std::set<int> > elementsSelected( m_numRegions );
+	int numElementsInSeveralRegions(0);
+	const int nElem = static_cast<int>( membership.offsets.size() ) - 1;
+	for( int iElem = 0; iElem < nElem; ++iElem ){
+		const int iBegin = membership.offsets[iElem];
+		const int iEnd = membership.offsets[iElem + 1];
+		if( iBegin == iEnd ){
+			continue;
+		}
+		if( iEnd - iBegin > 1 ){
+			++numElementsInSeveralRegions;
+		}
+		int iRegionSelected = membership.regions[iBegin];
+		for( int j = iBegin + 1; j < iEnd; ++j ){
+			if( m_priorities[ membership.regions[j] ] > m_priorities[iRegionSelected] ){
+				iRegionSelected = membership.regions[j];
+			}
+		}
+		elementsSelected[iRegionSelected].insert( elementsSelected[iRegionSelected].end(), iElem );
+	}
+	ofsLog << "Number of the elements located in several regions : " << numElementsInSeveralRegions << std::endl;
+
+	ResistivityBlockOverlay resistivityBlockMod(&resistivityBlock);
+	for( int iRegion = 0; iRegion < m_numRegions; ++iRegion ){
+		ofsLog << "Number of the selected elements of region " << iRegion << " : " << elementsSelected[iRegion].size() << std::endl;
+		resistivityBlockMod.changeResistivityOfSelectedElements( elementsSelected[iRegion],
+			m_modifiedResistivity[iRegion], m_modifiedMinResistivity[iRegion], m_modifiedMaxResistivity[iRegion] );
+	}
+	resistivityBlockMod.outputResisitivityBlock(ptrMeshData, iterNum, "");
+	resistivityBlockMod.outputResistivityValuesToBinary(isTetra, ptrMeshData, iterNum, "");
+
+}
@@ -0,0 +1,94 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#ifndef DBLDEF_MULTI_REGION
+#define DBLDEF_MULTI_REGION
+
+#include <iostream>
+#include "MeshData.h"
+#include "ResistivityBlock.h"
+#include "Region.h"
+#include "ElementSelector.h"
+
+// Class of model in which resistivity values are changed in many regions at once
+// An element located in several regions belongs to the region of the highest priority.
+// If the priorities are the same, the region specified first is taken.
+class MultiRegion{
+
+public:
+
+	// Constructer
+	MultiRegion();
+
+	// Destructer
+	~MultiRegion();
+
+	// Read parameters of the regions from input stream
+	void readParameters( std::istream& ifs );
+
+	// Get minimum resistivity of the elements to be changed
+	double getResistivityMin() const;
+
+	// Get maximum resistivity of the elements to be changed
+	double getResistivityMax() const;
+
+	// Change resistivity of the elements in the regions and output the modified model
+	// [note] : Messages are written to the specified stream
+	void execute( const bool isTetra, const MeshData* const ptrMeshData, const ResistivityBlock& resistivityBlock,
+		const ElementSelector& selector, const ElementSelector::Eligibility& eligibility, const int iterNum, std::ostream& ofsLog ) const;
+
+private:
+
+	// Copy constructer
+	MultiRegion(const MultiRegion& rhs);
+
+	// Copy assignment operator
+	MultiRegion& operator=(const MultiRegion& rhs);
+
+	// Minimum resistivity of the elements to be changed
+	double m_resistivityMin;
+
+	// Maximum resistivity of the elements to be changed
+	double m_resistivityMax;
+
+	// Number of regions
+	int m_numRegions;
+
+	// Array of regions
+	Region* m_regions;
+
+	// Array of priorities of the regions
+	int* m_priorities;
+
+	// Array of modified resistivity of the regions
+	double* m_modifiedResistivity;
+
+	// Array of modified minimum resistivity of the regions
+	double* m_modifiedMinResistivity;
+
+	// Array of modified maximum resistivity of the regions
+	double* m_modifiedMaxResistivity;
+
+};
+
+#endif
@@ -0,0 +1,437 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+#include <stdlib.h>
+#include <time.h>
+#ifdef _LINUX
+#include <string.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+#ifdef _USE_OMP
+#include <omp.h>
+#endif
+
+#include "PerformanceReport.h"
+#include "Tracer.h"
+
+namespace{
+// Nesting depth of the verification phase on the calling thread
+int depthOfVerification = 0;
+#pragma omp threadprivate(depthOfVerification)
+}
+
+const char* PerformanceReport::m_phaseNames[PerformanceReport::NUM_PHASES] = {
+	"mesh_input",
+	"mesh_reordering",
+	"block_input",
+	"preprocessing",
+	"selection",
+	"modification",
+	"output",
+	"verification",
+};
+
+const char* PerformanceReport::m_counterNames[PerformanceReport::NUM_COUNTERS] = {
+	"bytes_of_input_files",
+	"elements_tested",
+	"elements_accepted",
+	"blocks_fully_fixed",
+	"blocks_created",
+	"bytes_written",
+};
+
+PerformanceReport::PhaseStatistics PerformanceReport::m_phaseStatistics[PerformanceReport::NUM_PHASES];
+
+long long PerformanceReport::m_counters[PerformanceReport::NUM_COUNTERS];
+
+const char* PerformanceReport::m_hardwareCounterNames[PerformanceReport::NUM_HARDWARE_COUNTERS] = {
+	"cycles",
+	"instructions",
+	"llc_misses",
+	"dtlb_misses",
+};
+
+bool PerformanceReport::m_hardwareCountersEnabled = false;
+
+bool PerformanceReport::m_isHardwareCounterAvailable[PerformanceReport::NUM_HARDWARE_COUNTERS];
+
+std::vector<int> PerformanceReport::m_hardwareCounterFiles;
+
+std::vector<PerformanceReport::MemoryUsage> PerformanceReport::m_memoryUsages;
+
+double PerformanceReport::m_wallTimeOfProgramStart = PerformanceReport::getWallTime();
+
+// Constructer
+PerformanceReport::Timer::Timer( const int phase ):
+	m_phase(phase),
+	m_isRecorded( phase == VERIFICATION || depthOfVerification == 0 ),
+	m_wallTimeStart( getWallTime() ),
+	m_cpuTimeStart( getCPUTime() ),
+	m_peakRSSStart( getPeakRSS() )
+{
+	readHardwareCounters(m_hardwareCountsStart);
+	if( phase == VERIFICATION ){
+		++depthOfVerification;
+	}
+}
+
+// Destructer
+PerformanceReport::Timer::~Timer(){
+	if( m_phase == VERIFICATION ){
+		--depthOfVerification;
+	}
+	if( !m_isRecorded ){
+		return;
+	}
+	long long hardwareCounts[NUM_HARDWARE_COUNTERS];
+	readHardwareCounters(hardwareCounts);
+	for( int iCounter = 0; iCounter < NUM_HARDWARE_COUNTERS; ++iCounter ){
+		hardwareCounts[iCounter] -= m_hardwareCountsStart[iCounter];
+	}
+	const double wallTimeEnd = getWallTime();
+	addPhaseStatistics( m_phase, m_wallTimeStart, wallTimeEnd, getCPUTime() - m_cpuTimeStart, m_peakRSSStart, getPeakRSS(), hardwareCounts );
+	Tracer::addEvent( "phase", m_phaseNames[m_phase], m_wallTimeStart, wallTimeEnd );
+}
+
+// Copy constructer
+PerformanceReport::Timer::Timer(const Timer& rhs){
+	std::cerr << "Error : Copy constructer of the class PerformanceReport::Timer is not implemented." << std::endl;
+	exit(1);
+}
+
+// Assignment operator
+PerformanceReport::Timer& PerformanceReport::Timer::operator=(const Timer& rhs){
+	std::cerr << "Error : Assignment operator of the class PerformanceReport::Timer is not implemented." << std::endl;
+	exit(1);
+}
+
+// Constructer
+PerformanceReport::PerformanceReport(){
+}
+
+// Add value to a counter
+void PerformanceReport::addCount( const int counter, const long long value ){
+	if( depthOfVerification > 0 ){
+		return;
+	}
+#pragma omp atomic
+	m_counters[counter] += value;
+}
+
+// Add size of a file to a counter
+void PerformanceReport::addSizeOfFile( const int counter, const std::string& fileName ){
+
+	std::ifstream fin( fileName.c_str(), std::ios::in | std::ios::binary );
+	if( fin.fail() ){
+		return;
+	}
+	fin.seekg( 0, std::ios::end );
+	const long long size = static_cast<long long>( fin.tellg() );
+	if( size > 0 ){
+		addCount( counter, size );
+	}
+
+}
+
+// Get name of a phase
+const char* PerformanceReport::getPhaseName( const int phase ){
+	return m_phaseNames[phase];
+}
+
+// Get value of a counter
+long long PerformanceReport::getCount( const int counter ){
+	long long value(0);
+#pragma omp atomic read
+	value = m_counters[counter];
+	return value;
+}
+
+// Get wall clock time in second
+double PerformanceReport::getWallTime(){
+#if defined(_LINUX)
+	struct timespec ts;
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return static_cast<double>( ts.tv_sec ) + static_cast<double>( ts.tv_nsec ) * 1.0e-9;
+#elif defined(_USE_OMP)
+	return omp_get_wtime();
+#else
+	return static_cast<double>( time(NULL) );
+#endif
+}
+
+// Get CPU time of the process in second
+double PerformanceReport::getCPUTime(){
+#ifdef _LINUX
+	struct timespec ts;
+	clock_gettime( CLOCK_PROCESS_CPUTIME_ID, &ts );
+	return static_cast<double>( ts.tv_sec ) + static_cast<double>( ts.tv_nsec ) * 1.0e-9;
+#else
+	return static_cast<double>( clock() ) / static_cast<double>( CLOCKS_PER_SEC );
+#endif
+}
+
+// Get peak resident set size of the process in byte
+long long PerformanceReport::getPeakRSS(){
+#ifdef _LINUX
+	struct rusage usage;
+	if( getrusage( RUSAGE_SELF, &usage ) != 0 ){
+		return 0;
+	}
+	// ru_maxrss is in kilobyte on Linux
+	return static_cast<long long>( usage.ru_maxrss ) * 1024LL;
+#else
+	return 0;
+#endif
+}
+
+// Add allocated bytes of a data structure
+void PerformanceReport::addMemoryUsage( const std::string& name, const long long bytes ){
+
+#pragma omp critical (addMemoryUsage)
+	{
+		bool found(false);
+		for( std::vector<MemoryUsage>::iterator itr = m_memoryUsages.begin(); itr != m_memoryUsages.end(); ++itr ){
+			if( itr->name.compare(name) == 0 ){
+				itr->bytes = bytes;
+				found = true;
+				break;
+			}
+		}
+		if( !found ){
+			MemoryUsage usage;
+			usage.name = name;
+			usage.bytes = bytes;
+			m_memoryUsages.push_back(usage);
+		}
+	}
+
+}
+
+// Calculate bytes of heap block allocated for the specified bytes including the overhead of the allocator
+// [note] : The block of glibc malloc has a header of a pointer size and is aligned to twice the pointer size
+long long PerformanceReport::calcHeapBlockSize( const long long bytes ){
+
+	if( bytes <= 0 ){
+		return 0;
+	}
+	const long long alignment = 2 * static_cast<long long>( sizeof(void*) );
+	const long long size = ( bytes + static_cast<long long>( sizeof(void*) ) + alignment - 1 ) / alignment * alignment;
+	return std::max( size, 2 * alignment );
+
+}
+
+// Calculate bytes of a node of std::set or std::map including the overhead of the allocator
+// [note] : A node of the red-black tree has a color and three pointers in addition to the value
+long long PerformanceReport::calcTreeNodeSize( const long long bytesOfValue ){
+	return calcHeapBlockSize( 4 * static_cast<long long>( sizeof(void*) ) + bytesOfValue );
+}
+
+// Enable hardware performance counters of the threads and return whether any of them are available
+bool PerformanceReport::enableHardwareCounters(){
+
+	// The counters are inherited by all the threads created afterwards including those of nested parallel regions
+	m_hardwareCounterFiles.assign( NUM_HARDWARE_COUNTERS, -1 );
+	openHardwareCounters( &m_hardwareCounterFiles[0] );
+
+	bool isAvailable(false);
+	for( int iCounter = 0; iCounter < NUM_HARDWARE_COUNTERS; ++iCounter ){
+		m_isHardwareCounterAvailable[iCounter] = ( m_hardwareCounterFiles[iCounter] >= 0 );
+		if( m_isHardwareCounterAvailable[iCounter] ){
+			isAvailable = true;
+		}else{
+			std::cout << "Hardware performance counter " << m_hardwareCounterNames[iCounter] << " is not available" << std::endl;
+		}
+	}
+	m_hardwareCountersEnabled = isAvailable;
+	return isAvailable;
+
+}
+
+// Output report to file in JSON format
+void PerformanceReport::outputReport( const std::string& fileName ){
+
+	std::ofstream ofs( fileName.c_str(), std::ios::out | std::ios::trunc );
+	if( ofs.fail() ){
+		std::cerr << "File open error : " << fileName << " !!" << std::endl;
+		exit(1);
+	}
+
+	int numThreads(1);
+#ifdef _USE_OMP
+	numThreads = omp_get_max_threads();
+#endif
+
+	ofs << std::fixed << std::setprecision(6);
+	ofs << "{" << std::endl;
+	ofs << "  \"wall_time\": " << getWallTime() - m_wallTimeOfProgramStart << "," << std::endl;
+	ofs << "  \"cpu_time\": " << getCPUTime() << "," << std::endl;
+	ofs << "  \"max_threads\": " << numThreads << "," << std::endl;
+	ofs << "  \"peak_rss\": " << getPeakRSS() << "," << std::endl;
+	ofs << "  \"hardware_counters\": " << ( m_hardwareCountersEnabled ? "true" : "false" ) << "," << std::endl;
+	ofs << "  \"phases\": {" << std::endl;
+	for( int iPhase = 0; iPhase < NUM_PHASES; ++iPhase ){
+		const PhaseStatistics& stat = m_phaseStatistics[iPhase];
+		const double span = stat.numCalls > 0 ? stat.lastEnd - stat.firstStart : 0.0;
+		ofs << "    \"" << m_phaseNames[iPhase] << "\": { "
+			<< "\"calls\": " << stat.numCalls << ", "
+			<< "\"wall_time\": " << stat.wallTime << ", "
+			<< "\"cpu_time\": " << stat.cpuTime << ", "
+			<< "\"span\": " << span << ", "
+			<< "\"peak_rss\": " << stat.peakRSS << ", "
+			<< "\"peak_rss_increase\": " << stat.peakRSSIncrease;
+		if( m_hardwareCountersEnabled ){
+			// Unavailable counters are null
+			for( int iCounter = 0; iCounter < NUM_HARDWARE_COUNTERS; ++iCounter ){
+				ofs << ", \"" << m_hardwareCounterNames[iCounter] << "\": ";
+				if( m_isHardwareCounterAvailable[iCounter] ){
+					ofs << stat.hardwareCounts[iCounter];
+				}else{
+					ofs << "null";
+				}
+			}
+		}
+		ofs << " }"
+			<< ( iPhase + 1 < NUM_PHASES ? "," : "" ) << std::endl;
+	}
+	ofs << "  }," << std::endl;
+	ofs << "  \"counters\": {" << std::endl;
+	for( int iCounter = 0; iCounter < NUM_COUNTERS; ++iCounter ){
+		ofs << "    \"" << m_counterNames[iCounter] << "\": " << getCount(iCounter)
+			<< ( iCounter + 1 < NUM_COUNTERS ? "," : "" ) << std::endl;
+	}
+	ofs << "  }," << std::endl;
+	long long totalBytes(0);
+	ofs << "  \"memory\": {" << std::endl;
+	for( std::vector<MemoryUsage>::const_iterator itr = m_memoryUsages.begin(); itr != m_memoryUsages.end(); ++itr ){
+		ofs << "    \"" << itr->name << "\": " << itr->bytes << "," << std::endl;
+		totalBytes += itr->bytes;
+	}
+	ofs << "    \"total\": " << totalBytes << std::endl;
+	ofs << "  }" << std::endl;
+	ofs << "}" << std::endl;
+
+	ofs.close();
+
+}
+
+// Add statistics of a call of a phase
+void PerformanceReport::addPhaseStatistics( const int phase, const double wallTimeStart, const double wallTimeEnd, const double cpuTime,
+	const long long peakRSSStart, const long long peakRSSEnd, const long long* hardwareCounts ){
+
+#pragma omp critical (addPhaseStatistics)
+	{
+		PhaseStatistics& stat = m_phaseStatistics[phase];
+		if( stat.numCalls == 0 || wallTimeStart < stat.firstStart ){
+			stat.firstStart = wallTimeStart;
+		}
+		if( stat.numCalls == 0 || wallTimeEnd > stat.lastEnd ){
+			stat.lastEnd = wallTimeEnd;
+		}
+		stat.peakRSS = std::max( stat.peakRSS, peakRSSEnd );
+		stat.peakRSSIncrease += peakRSSEnd - peakRSSStart;
+		++stat.numCalls;
+		stat.wallTime += wallTimeEnd - wallTimeStart;
+		stat.cpuTime += cpuTime;
+		for( int iCounter = 0; iCounter < NUM_HARDWARE_COUNTERS; ++iCounter ){
+			stat.hardwareCounts[iCounter] += hardwareCounts[iCounter];
+		}
+	}
+
+}
+
+// Read the sums of the hardware performance counters over the threads
+// [note] : The count of an inherited counter includes those of all the threads inheriting it
+void PerformanceReport::readHardwareCounters( long long* values ){
+
+	for( int iCounter = 0; iCounter < NUM_HARDWARE_COUNTERS; ++iCounter ){
+		values[iCounter] = 0;
+	}
+	if( !m_hardwareCountersEnabled ){
+		return;
+	}
+
+#ifdef _LINUX
+	const int numFiles = static_cast<int>( m_hardwareCounterFiles.size() );
+	for( int i = 0; i < numFiles; ++i ){
+		if( m_hardwareCounterFiles[i] < 0 ){
+			continue;
+		}
+		// Value, time enabled and time running
+		unsigned long long buffer[3] = { 0, 0, 0 };
+		if( read( m_hardwareCounterFiles[i], buffer, sizeof(buffer) ) != static_cast<ssize_t>( sizeof(buffer) ) ){
+			continue;
+		}
+		// The value is scaled if the counter is multiplexed with the others
+		double value = static_cast<double>( buffer[0] );
+		if( buffer[2] > 0 && buffer[2] < buffer[1] ){
+			value *= static_cast<double>( buffer[1] ) / static_cast<double>( buffer[2] );
+		}
+		values[ i % NUM_HARDWARE_COUNTERS ] += static_cast<long long>( value );
+	}
+#endif
+
+}
+
+// Open the hardware performance counters of the calling thread which are inherited by the threads created afterwards
+void PerformanceReport::openHardwareCounters( int* files ){
+
+#ifdef _LINUX
+	const unsigned int types[NUM_HARDWARE_COUNTERS] = {
+		PERF_TYPE_HARDWARE,
+		PERF_TYPE_HARDWARE,
+		PERF_TYPE_HW_CACHE,
+		PERF_TYPE_HW_CACHE,
+	};
+	const unsigned long long configs[NUM_HARDWARE_COUNTERS] = {
+		PERF_COUNT_HW_CPU_CYCLES,
+		PERF_COUNT_HW_INSTRUCTIONS,
+		PERF_COUNT_HW_CACHE_LL | ( PERF_COUNT_HW_CACHE_OP_READ << 8 ) | ( PERF_COUNT_HW_CACHE_RESULT_MISS << 16 ),
+		PERF_COUNT_HW_CACHE_DTLB | ( PERF_COUNT_HW_CACHE_OP_READ << 8 ) | ( PERF_COUNT_HW_CACHE_RESULT_MISS << 16 ),
+	};
+	for( int iCounter = 0; iCounter < NUM_HARDWARE_COUNTERS; ++iCounter ){
+		struct perf_event_attr attr;
+		memset( &attr, 0, sizeof(attr) );
+		attr.size = sizeof(attr);
+		attr.type = types[iCounter];
+		attr.config = configs[iCounter];
+		attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+		// Only the user space is counted so that the counters are available to unprivileged users
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		attr.inherit = 1;
+		files[iCounter] = static_cast<int>( syscall( SYS_perf_event_open, &attr, 0, -1, -1, 0 ) );
+	}
+#else
+	for( int iCounter = 0; iCounter < NUM_HARDWARE_COUNTERS; ++iCounter ){
+		files[iCounter] = -1;
+	}
+#endif
+
+}
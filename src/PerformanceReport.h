@@ -0,0 +1,239 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#ifndef DBLDEF_PERFORMANCE_REPORT
+#define DBLDEF_PERFORMANCE_REPORT
+
+#include <string>
+#include <vector>
+
+// Class of report of elapsed times and counters of the processing phases
+// The times and counters are accumulated over the whole run by all the threads and written in JSON format.
+// Allocated bytes of the main data structures and the peak resident set size of the process are reported as well.
+// [note] : When a phase is executed concurrently ( e.g. for several scenarios ), the sums of the times of
+//          the calls exceed the span between the first start and the last end of the phase.
+//          The increase of the peak resident set size during concurrent calls is counted for all of them.
+//          The CPU time of a phase is that of the whole process during its calls, which includes the worker threads
+//          of the phase but also the other threads running concurrently. The CPU times of the phases overlap
+//          and their sum can exceed the CPU time of the whole run, which is reported separately.
+//          The counts of the hardware performance counters of a phase are those of all the threads during its calls,
+//          so that they overlap among the phases executed concurrently in the same way as the CPU times.
+//          The phases and the counters within the verification phase on the same thread are not recorded,
+//          so that the work of the reference implementations is reported only as the verification phase.
+class PerformanceReport{
+
+public:
+
+	enum Phases{
+		MESH_INPUT = 0,
+		MESH_REORDERING,
+		BLOCK_INPUT,
+		PREPROCESSING,
+		SELECTION,
+		MODIFICATION,
+		OUTPUT,
+		VERIFICATION,
+		NUM_PHASES,
+	};
+
+	// [note] : Elements of the blocks located inside the region are accepted without being tested
+	//          Sizes of the input files are added when the files are parsed, so they are not the bytes actually read
+	//          from the storage. Input files not parsed ( e.g. mesh data attached from the shared memory ) are not counted.
+	enum Counters{
+		BYTES_OF_INPUT_FILES = 0,
+		ELEMENTS_TESTED,
+		ELEMENTS_ACCEPTED,
+		BLOCKS_FULLY_FIXED,
+		BLOCKS_CREATED,
+		BYTES_WRITTEN,
+		NUM_COUNTERS,
+	};
+
+	// Hardware performance counters measured optionally
+	enum HardwareCounters{
+		CYCLES = 0,
+		INSTRUCTIONS,
+		LLC_MISSES,
+		DTLB_MISSES,
+		NUM_HARDWARE_COUNTERS,
+	};
+
+	// Class of timer measuring a phase from its construction to its destruction
+	class Timer{
+
+	public:
+
+		// Constructer
+		explicit Timer( const int phase );
+
+		// Destructer
+		~Timer();
+
+	private:
+
+		// Copy constructer
+		Timer(const Timer& rhs);
+
+		// Copy assignment operator
+		Timer& operator=(const Timer& rhs);
+
+		// Phase measured by the timer
+		int m_phase;
+
+		// Flag specifing whether the phase is recorded
+		bool m_isRecorded;
+
+		// Wall clock time at the start
+		double m_wallTimeStart;
+
+		// CPU time of the process at the start
+		double m_cpuTimeStart;
+
+		// Peak resident set size of the process at the start
+		long long m_peakRSSStart;
+
+		// Values of the hardware performance counters at the start
+		long long m_hardwareCountsStart[NUM_HARDWARE_COUNTERS];
+
+	};
+
+	// Add value to a counter
+	static void addCount( const int counter, const long long value );
+
+	// Add size of a file to a counter
+	static void addSizeOfFile( const int counter, const std::string& fileName );
+
+	// Get name of a phase
+	static const char* getPhaseName( const int phase );
+
+	// Get value of a counter
+	static long long getCount( const int counter );
+
+	// Get wall clock time in second
+	static double getWallTime();
+
+	// Get CPU time of the process in second
+	static double getCPUTime();
+
+	// Get peak resident set size of the process in byte
+	// [note] : Zero is returned if it is not available
+	static long long getPeakRSS();
+
+	// Add allocated bytes of a data structure
+	// [note] : The bytes of a data structure reported more than once are replaced
+	static void addMemoryUsage( const std::string& name, const long long bytes );
+
+	// Calculate bytes of heap block allocated for the specified bytes including the overhead of the allocator
+	static long long calcHeapBlockSize( const long long bytes );
+
+	// Calculate bytes of a node of std::set or std::map including the overhead of the allocator
+	static long long calcTreeNodeSize( const long long bytesOfValue );
+
+	// Enable hardware performance counters of the threads and return whether any of them are available
+	// [note] : This must be called by the main thread before any parallel region is executed, so that the counters
+	//          are inherited by all the threads including those of nested parallel regions ( e.g. -threads N M ).
+	//          The counts during concurrent calls of the phases are counted for all of them.
+	static bool enableHardwareCounters();
+
+	// Output report to file in JSON format
+	static void outputReport( const std::string& fileName );
+
+private:
+
+	// Constructer
+	PerformanceReport();
+
+	// Statistics of a phase
+	struct PhaseStatistics{
+		// Number of calls
+		long long numCalls;
+		// Sum of wall clock times of the calls
+		double wallTime;
+		// Sum of CPU times of the process during the calls
+		// [note] : CPU times of the other phases executed concurrently are included
+		double cpuTime;
+		// Wall clock time of the first start
+		double firstStart;
+		// Wall clock time of the last end
+		double lastEnd;
+		// Sum of the increases of the peak resident set size during the calls
+		long long peakRSSIncrease;
+		// Peak resident set size at the last end
+		long long peakRSS;
+		// Sums of the counts of the hardware performance counters during the calls
+		long long hardwareCounts[NUM_HARDWARE_COUNTERS];
+	};
+
+	// Allocated bytes of a data structure
+	struct MemoryUsage{
+		// Name of the data structure
+		std::string name;
+		// Allocated bytes
+		long long bytes;
+	};
+
+	// Names of the phases
+	static const char* m_phaseNames[NUM_PHASES];
+
+	// Names of the counters
+	static const char* m_counterNames[NUM_COUNTERS];
+
+	// Statistics of the phases
+	static PhaseStatistics m_phaseStatistics[NUM_PHASES];
+
+	// Values of the counters
+	static long long m_counters[NUM_COUNTERS];
+
+	// Names of the hardware performance counters
+	static const char* m_hardwareCounterNames[NUM_HARDWARE_COUNTERS];
+
+	// Flag specifing whether the hardware performance counters are enabled
+	static bool m_hardwareCountersEnabled;
+
+	// Flags specifing whether each hardware performance counter is available
+	static bool m_isHardwareCounterAvailable[NUM_HARDWARE_COUNTERS];
+
+	// File descriptors of the hardware performance counters inherited by the threads
+	// [note] : -1 is stored for the counters which cannot be opened
+	static std::vector<int> m_hardwareCounterFiles;
+
+	// Allocated bytes of the data structures in the reported order
+	static std::vector<MemoryUsage> m_memoryUsages;
+
+	// Wall clock time at the start of the program
+	static double m_wallTimeOfProgramStart;
+
+	// Add statistics of a call of a phase
+	static void addPhaseStatistics( const int phase, const double wallTimeStart, const double wallTimeEnd, const double cpuTime,
+		const long long peakRSSStart, const long long peakRSSEnd, const long long* hardwareCounts );
+
+	// Read the sums of the hardware performance counters over the threads
+	// [note] : Zeros are returned if the counters are not enabled
+	static void readHardwareCounters( long long* values );
+
+	// Open the hardware performance counters of the calling thread which are inherited by the threads created afterwards
+	static void openHardwareCounters( int* files );
+
+};
+
+#endif
@@ -0,0 +1,135 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <stdlib.h>
+
+#include "ProgressReporter.h"
+#include "PerformanceReport.h"
+
+bool ProgressReporter::m_enabled = false;
+
+double ProgressReporter::m_interval = 10.0;
+
+// Constructer
+ProgressReporter::ProgressReporter( const std::string& fileName ):
+	m_fileName(fileName),
+	m_fileSize(0),
+	m_startTime(0.0),
+	m_lastReportTime(0.0),
+	m_finished(false)
+{
+	if( !m_enabled ){
+		return;
+	}
+	std::ifstream fin( fileName.c_str(), std::ios::in | std::ios::binary );
+	if( !fin.fail() ){
+		fin.seekg( 0, std::ios::end );
+		m_fileSize = static_cast<long long>( fin.tellg() );
+	}
+	m_startTime = PerformanceReport::getWallTime();
+	m_lastReportTime = m_startTime;
+}
+
+// Destructer
+ProgressReporter::~ProgressReporter(){
+	finish();
+}
+
+// Write summary of the reading if the reporting is enabled
+void ProgressReporter::finish(){
+	if( !m_enabled || m_finished ){
+		return;
+	}
+	m_finished = true;
+	const double elapsedTime = PerformanceReport::getWallTime() - m_startTime;
+	std::ostringstream oss;
+	oss << std::fixed << std::setprecision(1);
+	oss << m_fileName << " : " << formatSize(m_fileSize) << " MB read in " << elapsedTime << " sec";
+	if( elapsedTime > 0.0 ){
+		oss << " ( " << static_cast<double>( m_fileSize ) / elapsedTime * 1.0e-6 << " MB/s )";
+	}
+	oss << std::endl;
+#pragma omp critical (outputProgress)
+	std::cout << oss.str() << std::flush;
+}
+
+// Copy constructer
+ProgressReporter::ProgressReporter(const ProgressReporter& rhs){
+	std::cerr << "Error : Copy constructer of the class ProgressReporter is not implemented." << std::endl;
+	exit(1);
+}
+
+// Assignment operator
+ProgressReporter& ProgressReporter::operator=(const ProgressReporter& rhs){
+	std::cerr << "Error : Assignment operator of the class ProgressReporter is not implemented." << std::endl;
+	exit(1);
+}
+
+// Enable the reporting at the specified interval in second
+void ProgressReporter::enable( const double interval ){
+	m_enabled = true;
+	m_interval = interval;
+}
+
+// Report progress if the interval has passed since the last report
+void ProgressReporter::report( std::istream& ifs, const char* itemName, const long long numItems ){
+
+	const double time = PerformanceReport::getWallTime();
+	if( time - m_lastReportTime < m_interval ){
+		return;
+	}
+	m_lastReportTime = time;
+
+	// The offset of the stream tells the bytes parsed
+	const long long offset = static_cast<long long>( ifs.tellg() );
+	if( offset < 0 ){
+		return;
+	}
+	const double elapsedTime = time - m_startTime;
+	const double rate = elapsedTime > 0.0 ? static_cast<double>( offset ) / elapsedTime : 0.0;
+
+	std::ostringstream oss;
+	oss << std::fixed << std::setprecision(1);
+	oss << m_fileName << " : " << formatSize(offset) << " / " << formatSize(m_fileSize) << " MB";
+	if( m_fileSize > 0 ){
+		oss << " ( " << 100.0 * static_cast<double>( offset ) / static_cast<double>( m_fileSize ) << "% )";
+	}
+	oss << ", " << numItems << " " << itemName << ", " << rate * 1.0e-6 << " MB/s";
+	if( rate > 0.0 && m_fileSize >= offset ){
+		oss << ", ETA " << static_cast<double>( m_fileSize - offset ) / rate << " sec";
+	}
+	oss << std::endl;
+#pragma omp critical (outputProgress)
+	std::cout << oss.str() << std::flush;
+
+}
+
+// Format size in megabyte
+std::string ProgressReporter::formatSize( const long long bytes ){
+	std::ostringstream oss;
+	oss << std::fixed << std::setprecision(1) << static_cast<double>( bytes ) * 1.0e-6;
+	return oss.str();
+}
@@ -0,0 +1,98 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#ifndef DBLDEF_PROGRESS_REPORTER
+#define DBLDEF_PROGRESS_REPORTER
+
+#include <iostream>
+#include <string>
+
+// Class reporting progress of reading a file periodically
+// The bytes read, the number of the items parsed, the throughput and the estimated remaining time are written to stdout.
+// [note] : When the reporting is not enabled, an update only tests a flag
+class ProgressReporter{
+
+public:
+
+	// Constructer
+	explicit ProgressReporter( const std::string& fileName );
+
+	// Destructer
+	// [note] : Summary of the reading is written if it has not been written
+	~ProgressReporter();
+
+	// Write summary of the reading if the reporting is enabled
+	void finish();
+
+	// Enable the reporting at the specified interval in second
+	static void enable( const double interval );
+
+	// Update progress with the number of the items parsed from the stream
+	void update( std::istream& ifs, const char* itemName, const long long numItems ){
+		if( !m_enabled || ( numItems & m_checkMask ) != 0 ){
+			return;
+		}
+		report( ifs, itemName, numItems );
+	}
+
+private:
+
+	// Copy constructer
+	ProgressReporter(const ProgressReporter& rhs);
+
+	// Copy assignment operator
+	ProgressReporter& operator=(const ProgressReporter& rhs);
+
+	// Flag specifing whether the reporting is enabled
+	static bool m_enabled;
+
+	// Interval of the reporting in second
+	static double m_interval;
+
+	// Mask of the number of the items at which the time is checked
+	static const long long m_checkMask = 0x3FFF;
+
+	// Name of the file
+	std::string m_fileName;
+
+	// Size of the file in byte
+	long long m_fileSize;
+
+	// Wall clock time at the start
+	double m_startTime;
+
+	// Wall clock time of the last report
+	double m_lastReportTime;
+
+	// Flag specifing whether the summary has been written
+	bool m_finished;
+
+	// Report progress if the interval has passed since the last report
+	void report( std::istream& ifs, const char* itemName, const long long numItems );
+
+	// Format size in megabyte
+	static std::string formatSize( const long long bytes );
+
+};
+
+#endif
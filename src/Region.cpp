@@ -0,0 +1,306 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#include <iostream>
+#include <math.h>
+#include <stdlib.h>
+
+#include "Region.h"
+#include "CompositeRegion.h"
+
+// Constructer
+Region::Region():
+	m_regionType(ELLIPSOID),
+	m_xHalfLength(0.0),
+	m_yHalfLength(0.0),
+	m_zHalfLength(0.0),
+	m_angle(0.0),
+	m_cosAngle(1.0),
+	m_sinAngle(0.0)
+{
+	m_center.X = 0.0;
+	m_center.Y = 0.0;
+	m_center.Z = 0.0;
+}
+
+// Destructer
+Region::~Region(){
+}
+
+// Create region whose parameters are read from input stream
+Region* Region::createRegion( std::istream& ifs ){
+
+	int type(ELLIPSOID);
+	ifs >> type;
+	if( type == COMPOSITE ){
+		std::cout << "Region type : Composite" << std::endl;
+		CompositeRegion* const ptrRegion = new CompositeRegion;
+		ptrRegion->readComponents(ifs);
+		return ptrRegion;
+	}
+
+	Region* const ptrRegion = new Region;
+	ptrRegion->readParametersOfPrimitive( type, ifs );
+	return ptrRegion;
+
+}
+
+// Read parameters of the region from input stream
+void Region::readParameters( std::istream& ifs ){
+
+	int type(ELLIPSOID);
+	ifs >> type;
+	readParametersOfPrimitive( type, ifs );
+
+}
+
+// Read parameters of the primitive region following its type from input stream
+void Region::readParametersOfPrimitive( const int type, std::istream& ifs ){
+
+	m_regionType = type;
+	switch (m_regionType){
+		case ELLIPSOID:
+			std::cout << "Region type : Ellipsoid" << std::endl;
+			break;
+		case CUBOID:
+			std::cout << "Region type : Cuboid" << std::endl;
+			break;
+		case CYLINDROID:
+			std::cout << "Region type : Cylindroid" << std::endl;
+			break;
+		default:
+			std::cout << "Region type is wrong : " << m_regionType << std::endl;
+			exit(1);
+	}
+
+	double xLength(0.0);
+	double yLength(0.0);
+	double zLength(0.0);
+	ifs >> xLength;
+	std::cout << "Length of x axis [km] : " << xLength << std::endl;
+	ifs >> yLength;
+	std::cout << "Length of y axis [km] : " << yLength << std::endl;
+	ifs >> zLength;
+	std::cout << "Length of z axis [km] : " << zLength << std::endl;
+
+	CommonParameters::locationXYZ center = { 0.0, 0.0, 0.0 };
+	ifs >> center.X;
+	std::cout << "X coordinate of the center [km] : " << center.X << std::endl;
+	ifs >> center.Y;
+	std::cout << "Y coordinate of the center [km] : " << center.Y << std::endl;
+	ifs >> center.Z;
+	std::cout << "Z coordinate of the center [km] : " << center.Z << std::endl;
+
+	double angle(0.0);
+	ifs >> angle;
+	std::cout << "Rotation angle [deg.] : " << angle << std::endl;
+
+	center.X *= 1000.0;
+	center.Y *= 1000.0;
+	center.Z *= 1000.0;
+	setParameters( m_regionType, center, xLength * 1000.0, yLength * 1000.0, zLength * 1000.0, angle * CommonParameters::deg2rad );
+
+}
+
+// Set parameters of the region
+void Region::setParameters( const int type, const CommonParameters::locationXYZ& center,
+	const double xLength, const double yLength, const double zLength, const double angle ){
+
+	m_regionType = type;
+	m_center = center;
+	m_xHalfLength = xLength * 0.5;
+	m_yHalfLength = yLength * 0.5;
+	m_zHalfLength = zLength * 0.5;
+	m_angle = angle;
+	m_cosAngle = cos( - m_angle );
+	m_sinAngle = sin( - m_angle );
+
+}
+
+// Get type of the region
+int Region::getRegionType() const{
+	return m_regionType;
+}
+
+// Determine whether the region is a cuboid whose faces are parallel to the coordinate planes
+bool Region::isAxisAlignedCuboid() const{
+	return m_regionType == CUBOID && fabs(m_sinAngle) < CommonParameters::EPS;
+}
+
+// Calculate axis-aligned bounding box of the region
+void Region::calcBoundingBox( CommonParameters::locationXYZ& minCoord, CommonParameters::locationXYZ& maxCoord ) const{
+
+	double xHalfWidth(0.0);
+	double yHalfWidth(0.0);
+	if( m_regionType == CUBOID ){
+		xHalfWidth = m_xHalfLength * fabs(m_cosAngle) + m_yHalfLength * fabs(m_sinAngle);
+		yHalfWidth = m_xHalfLength * fabs(m_sinAngle) + m_yHalfLength * fabs(m_cosAngle);
+	}else{
+		// Horizontal cross section is an ellipse
+		xHalfWidth = hypot( m_xHalfLength * m_cosAngle, m_yHalfLength * m_sinAngle );
+		yHalfWidth = hypot( m_xHalfLength * m_sinAngle, m_yHalfLength * m_cosAngle );
+	}
+
+	minCoord.X = m_center.X - xHalfWidth;
+	minCoord.Y = m_center.Y - yHalfWidth;
+	minCoord.Z = m_center.Z - m_zHalfLength;
+	maxCoord.X = m_center.X + xHalfWidth;
+	maxCoord.Y = m_center.Y + yHalfWidth;
+	maxCoord.Z = m_center.Z + m_zHalfLength;
+
+}
+
+// Determine whether the specified box is located inside or outside of the region
+int Region::locateBox( const CommonParameters::BoundingBox& box ) const{
+
+	// The box is enlarged slightly so that the result does not depend on round-off errors
+	const double margin = 1.0e-6;
+	const double xMin = box.minCoord.X - margin;
+	const double yMin = box.minCoord.Y - margin;
+	const double zMin = box.minCoord.Z - margin;
+	const double xMax = box.maxCoord.X + margin;
+	const double yMax = box.maxCoord.Y + margin;
+	const double zMax = box.maxCoord.Z + margin;
+
+	CommonParameters::locationXYZ minCoord = { 0.0, 0.0, 0.0 };
+	CommonParameters::locationXYZ maxCoord = { 0.0, 0.0, 0.0 };
+	calcBoundingBox( minCoord, maxCoord );
+	if( xMax < minCoord.X || xMin > maxCoord.X || yMax < minCoord.Y || yMin > maxCoord.Y || zMax < minCoord.Z || zMin > maxCoord.Z ){
+		return OUTSIDE_OF_REGION;
+	}
+
+	// Because all the region types are convex, the box is inside of the region if all its corners are inside
+	const double x[8] = { xMin, xMax, xMax, xMin, xMin, xMax, xMax, xMin };
+	const double y[8] = { yMin, yMin, yMax, yMax, yMin, yMin, yMax, yMax };
+	const double z[8] = { zMin, zMin, zMin, zMin, zMax, zMax, zMax, zMax };
+	unsigned char flags[8];
+	inRegion( 8, x, y, z, flags );
+	for( int i = 0; i < 8; ++i ){
+		if( flags[i] == 0 ){
+			return CROSSING_BOUNDARY;
+		}
+	}
+	return INSIDE_OF_REGION;
+
+}
+
+// Determine whether the specified point is located in the region
+bool Region::inRegion( const CommonParameters::locationXYZ& coord ) const{
+
+	const CommonParameters::locationXYZ coordFromCenter = { coord.X - m_center.X, coord.Y - m_center.Y, coord.Z - m_center.Z }; 
+	CommonParameters::locationXYZ coordRotated = { 0.0, 0.0, 0.0};
+	coordRotated.X = coordFromCenter.X * m_cosAngle - coordFromCenter.Y * m_sinAngle;
+	coordRotated.Y = coordFromCenter.X * m_sinAngle + coordFromCenter.Y * m_cosAngle;
+	coordRotated.Z = coordFromCenter.Z;
+	
+	if( m_regionType == ELLIPSOID ){
+		const double val = pow( coordRotated.X / m_xHalfLength, 2 ) + pow( coordRotated.Y / m_yHalfLength, 2 ) + pow( coordRotated.Z / m_zHalfLength, 2 );
+		if( val <= 1.0 ){
+			return true;
+		}
+	}
+	else if( m_regionType == CUBOID ){
+		if( fabs(coordRotated.X) <= m_xHalfLength && fabs(coordRotated.Y) <= m_yHalfLength && fabs(coordRotated.Z) <= m_zHalfLength ){
+			return true;
+		}
+	}
+	else if( m_regionType == CYLINDROID ){
+		const double val = pow( coordRotated.X / m_xHalfLength, 2 ) + pow( coordRotated.Y / m_yHalfLength, 2 );
+		if( val <= 1.0 && fabs(coordRotated.Z) <= m_zHalfLength ){
+			return true;
+		}
+	}
+	else{
+		std::cout << "Region type is wrong : " << m_regionType << std::endl;
+		exit(1);
+	}
+
+	return false;
+
+}
+
+// Determine whether the specified points are located in the region
+void Region::inRegion( const int numPoints, const double* x, const double* y, const double* z, unsigned char* flags ) const{
+
+	const double xCenter = m_center.X;
+	const double yCenter = m_center.Y;
+	const double zCenter = m_center.Z;
+	const double cosAngle = m_cosAngle;
+	const double sinAngle = m_sinAngle;
+	const double xHalfLength = m_xHalfLength;
+	const double yHalfLength = m_yHalfLength;
+	const double zHalfLength = m_zHalfLength;
+
+	switch (m_regionType){
+		case ELLIPSOID:
+#pragma omp simd
+			for( int i = 0; i < numPoints; ++i ){
+				const double xFromCenter = x[i] - xCenter;
+				const double yFromCenter = y[i] - yCenter;
+				const double xRotated = ( xFromCenter * cosAngle - yFromCenter * sinAngle ) / xHalfLength;
+				const double yRotated = ( xFromCenter * sinAngle + yFromCenter * cosAngle ) / yHalfLength;
+				const double zRotated = ( z[i] - zCenter ) / zHalfLength;
+				flags[i] = xRotated * xRotated + yRotated * yRotated + zRotated * zRotated <= 1.0;
+			}
+			break;
+		case CUBOID:
+#pragma omp simd
+			for( int i = 0; i < numPoints; ++i ){
+				const double xFromCenter = x[i] - xCenter;
+				const double yFromCenter = y[i] - yCenter;
+				const double xRotated = xFromCenter * cosAngle - yFromCenter * sinAngle;
+				const double yRotated = xFromCenter * sinAngle + yFromCenter * cosAngle;
+				const double zRotated = z[i] - zCenter;
+				flags[i] = ( fabs(xRotated) <= xHalfLength ) & ( fabs(yRotated) <= yHalfLength ) & ( fabs(zRotated) <= zHalfLength );
+			}
+			break;
+		case CYLINDROID:
+#pragma omp simd
+			for( int i = 0; i < numPoints; ++i ){
+				const double xFromCenter = x[i] - xCenter;
+				const double yFromCenter = y[i] - yCenter;
+				const double xRotated = ( xFromCenter * cosAngle - yFromCenter * sinAngle ) / xHalfLength;
+				const double yRotated = ( xFromCenter * sinAngle + yFromCenter * cosAngle ) / yHalfLength;
+				const double zRotated = z[i] - zCenter;
+				flags[i] = ( xRotated * xRotated + yRotated * yRotated <= 1.0 ) & ( fabs(zRotated) <= zHalfLength );
+			}
+			break;
+		default:
+			std::cout << "Region type is wrong : " << m_regionType << std::endl;
+			exit(1);
+			break;
+	}
+
+}
+
+// Write parameters of the region in canonical form
+void Region::writeCanonicalParameters( std::ostream& ofs ) const{
+
+	const std::streamsize precisionOrg = ofs.precision(17);
+	ofs << "REGION " << m_regionType
+		<< " " << m_center.X << " " << m_center.Y << " " << m_center.Z
+		<< " " << m_xHalfLength << " " << m_yHalfLength << " " << m_zHalfLength
+		<< " " << m_angle << std::endl;
+	ofs.precision(precisionOrg);
+
+}
@@ -0,0 +1,118 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#ifndef DBLDEF_REGION
+#define DBLDEF_REGION
+
+#include <iostream>
+#include "CommonParameters.h"
+
+// Class of region in which resistivity values are changed
+class Region{
+
+public:
+
+	enum RegionType{
+		ELLIPSOID = 0,
+		CUBOID,
+		CYLINDROID,
+		COMPOSITE,
+	};
+
+	enum BoxLocation{
+		OUTSIDE_OF_REGION = 0,
+		INSIDE_OF_REGION,
+		CROSSING_BOUNDARY,
+	};
+
+	// Constructer
+	Region();
+
+	// Destructer
+	virtual ~Region();
+
+	// Create region whose parameters are read from input stream
+	// [note] : Composite regions can be created as well as primitive ones. The region must be deleted by the caller.
+	static Region* createRegion( std::istream& ifs );
+
+	// Read parameters of the region from input stream
+	// [note] : Only primitive regions can be read by this function
+	void readParameters( std::istream& ifs );
+
+	// Set parameters of the region
+	// [note] : Lengths are full lengths in meter and the angle is in radian
+	void setParameters( const int type, const CommonParameters::locationXYZ& center,
+		const double xLength, const double yLength, const double zLength, const double angle );
+
+	// Get type of the region
+	int getRegionType() const;
+
+	// Determine whether the region is a cuboid whose faces are parallel to the coordinate planes
+	virtual bool isAxisAlignedCuboid() const;
+
+	// Calculate axis-aligned bounding box of the region
+	virtual void calcBoundingBox( CommonParameters::locationXYZ& minCoord, CommonParameters::locationXYZ& maxCoord ) const;
+
+	// Determine whether the specified box is located inside or outside of the region
+	// [note] : CROSSING_BOUNDARY may be returned for a box which is actually inside or outside
+	virtual int locateBox( const CommonParameters::BoundingBox& box ) const;
+
+	// Determine whether the specified point is located in the region
+	virtual bool inRegion( const CommonParameters::locationXYZ& coord ) const;
+
+	// Determine whether the specified points are located in the region
+	// [note] : This function is written without branches so that it can be vectorized
+	virtual void inRegion( const int numPoints, const double* x, const double* y, const double* z, unsigned char* flags ) const;
+
+	// Write parameters of the region in canonical form
+	// [note] : The regions selecting the same elements are written identically regardless of the format of the input
+	virtual void writeCanonicalParameters( std::ostream& ofs ) const;
+
+protected:
+
+	// Read parameters of the primitive region following its type from input stream
+	void readParametersOfPrimitive( const int type, std::istream& ifs );
+
+	// Type of the region
+	int m_regionType;
+
+	// Coordinate of the center of the region
+	CommonParameters::locationXYZ m_center;
+
+	// Half lengths of the region along its axes
+	double m_xHalfLength;
+	double m_yHalfLength;
+	double m_zHalfLength;
+
+	// Rotation angle around the Z axis
+	double m_angle;
+
+	// Cosine of the rotation angle for transforming coordinates to the region
+	double m_cosAngle;
+
+	// Sine of the rotation angle for transforming coordinates to the region
+	double m_sinAngle;
+
+};
+
+#endif
@@ -0,0 +1,194 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#include <iostream>
+#include <algorithm>
+#include <assert.h>
+
+#include "RegionIndex.h"
+
+namespace{
+
+// Functor comparing centers of bounding boxes along an axis
+class BoxCenterComparator{
+public:
+	BoxCenterComparator( const std::vector<CommonParameters::BoundingBox>& boxes, const int axis ):
+		m_boxes(boxes), m_axis(axis)
+	{}
+	bool operator()( const int lhs, const int rhs ) const{
+		return center(lhs) < center(rhs);
+	}
+private:
+	double center( const int i ) const{
+		switch( m_axis ){
+			case 0:
+				return m_boxes[i].minCoord.X + m_boxes[i].maxCoord.X;
+			case 1:
+				return m_boxes[i].minCoord.Y + m_boxes[i].maxCoord.Y;
+			default:
+				return m_boxes[i].minCoord.Z + m_boxes[i].maxCoord.Z;
+		}
+	}
+	const std::vector<CommonParameters::BoundingBox>& m_boxes;
+	int m_axis;
+};
+
+}
+
+// Constructer
+RegionIndex::RegionIndex( const int numRegions, const Region* const regions ):
+	m_numRegions(numRegions),
+	m_regions(regions)
+{
+
+	m_boxes.resize(m_numRegions);
+	m_sortedRegions.resize(m_numRegions);
+	// Boxes are enlarged slightly so that the result does not depend on round-off errors
+	const double margin = 1.0e-6;
+	for( int iRegion = 0; iRegion < m_numRegions; ++iRegion ){
+		CommonParameters::BoundingBox& box = m_boxes[iRegion];
+		m_regions[iRegion].calcBoundingBox( box.minCoord, box.maxCoord );
+		box.minCoord.X -= margin;
+		box.minCoord.Y -= margin;
+		box.minCoord.Z -= margin;
+		box.maxCoord.X += margin;
+		box.maxCoord.Y += margin;
+		box.maxCoord.Z += margin;
+		m_sortedRegions[iRegion] = iRegion;
+	}
+
+	if( m_numRegions > 0 ){
+		m_nodes.reserve( 2 * m_numRegions );
+		m_nodes.resize(1);
+		buildNode( 0, 0, m_numRegions );
+	}
+
+}
+
+// Destructer
+RegionIndex::~RegionIndex(){
+}
+
+// Copy constructer
+RegionIndex::RegionIndex(const RegionIndex& rhs){
+	std::cerr << "Error : Copy constructer of the class RegionIndex is not implemented." << std::endl;
+	exit(1);
+}
+
+// Assignment operator
+RegionIndex& RegionIndex::operator=(const RegionIndex& rhs){
+	std::cerr << "Error : Assignment operator of the class RegionIndex is not implemented." << std::endl;
+	exit(1);
+}
+
+// Get number of regions
+int RegionIndex::getNumRegions() const{
+	return m_numRegions;
+}
+
+// Get region
+const Region& RegionIndex::getRegion( const int iRegion ) const{
+	assert( iRegion >= 0 );
+	assert( iRegion < m_numRegions );
+	return m_regions[iRegion];
+}
+
+// Find regions containing the specified point
+void RegionIndex::findRegionsContainingPoint( const double x, const double y, const double z, std::vector<int>& regionsFound ) const{
+
+	if( m_nodes.empty() ){
+		return;
+	}
+
+	const int numFoundBefore = static_cast<int>( regionsFound.size() );
+	int stack[64];
+	int numStack(0);
+	stack[numStack++] = 0;
+	while( numStack > 0 ){
+		const Node& node = m_nodes[ stack[--numStack] ];
+		if( x < node.box.minCoord.X || x > node.box.maxCoord.X ||
+			y < node.box.minCoord.Y || y > node.box.maxCoord.Y ||
+			z < node.box.minCoord.Z || z > node.box.maxCoord.Z ){
+			continue;
+		}
+		if( node.firstChild >= 0 ){
+			stack[numStack++] = node.firstChild;
+			stack[numStack++] = node.firstChild + 1;
+			continue;
+		}
+		for( int i = node.begin; i < node.end; ++i ){
+			const int iRegion = m_sortedRegions[i];
+			unsigned char flag(0);
+			m_regions[iRegion].inRegion( 1, &x, &y, &z, &flag );
+			if( flag != 0 ){
+				regionsFound.push_back(iRegion);
+			}
+		}
+	}
+	std::sort( regionsFound.begin() + numFoundBefore, regionsFound.end() );
+
+}
+
+// Build the hierarchy for the specified range of the sorted regions
+// Regions are split at the median of the centers of their boxes along the longest axis.
+void RegionIndex::buildNode( const int iNode, const int begin, const int end ){
+
+	CommonParameters::BoundingBox box = m_boxes[ m_sortedRegions[begin] ];
+	for( int i = begin + 1; i < end; ++i ){
+		const CommonParameters::BoundingBox& boxRegion = m_boxes[ m_sortedRegions[i] ];
+		box.minCoord.X = std::min( box.minCoord.X, boxRegion.minCoord.X );
+		box.minCoord.Y = std::min( box.minCoord.Y, boxRegion.minCoord.Y );
+		box.minCoord.Z = std::min( box.minCoord.Z, boxRegion.minCoord.Z );
+		box.maxCoord.X = std::max( box.maxCoord.X, boxRegion.maxCoord.X );
+		box.maxCoord.Y = std::max( box.maxCoord.Y, boxRegion.maxCoord.Y );
+		box.maxCoord.Z = std::max( box.maxCoord.Z, boxRegion.maxCoord.Z );
+	}
+	m_nodes[iNode].box = box;
+	m_nodes[iNode].firstChild = -1;
+	m_nodes[iNode].begin = begin;
+	m_nodes[iNode].end = end;
+
+	if( end - begin <= m_maxNumRegionsInLeaf ){
+		return;
+	}
+
+	const double xWidth = box.maxCoord.X - box.minCoord.X;
+	const double yWidth = box.maxCoord.Y - box.minCoord.Y;
+	const double zWidth = box.maxCoord.Z - box.minCoord.Z;
+	int axis(2);
+	if( xWidth >= yWidth && xWidth >= zWidth ){
+		axis = 0;
+	}else if( yWidth >= zWidth ){
+		axis = 1;
+	}
+	const int middle = ( begin + end ) / 2;
+	std::nth_element( m_sortedRegions.begin() + begin, m_sortedRegions.begin() + middle, m_sortedRegions.begin() + end,
+		BoxCenterComparator( m_boxes, axis ) );
+
+	const int firstChild = static_cast<int>( m_nodes.size() );
+	m_nodes.resize( firstChild + 2 );
+	m_nodes[iNode].firstChild = firstChild;
+	buildNode( firstChild, begin, middle );
+	buildNode( firstChild + 1, middle, end );
+
+}
@@ -0,0 +1,104 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#ifndef DBLDEF_REGION_INDEX
+#define DBLDEF_REGION_INDEX
+
+#include <vector>
+#include "CommonParameters.h"
+#include "Region.h"
+
+// Class of bounding volume hierarchy over the bounding boxes of regions
+class RegionIndex{
+
+public:
+
+	// Sparse matrix of membership of elements to regions in compressed row storage
+	struct Membership{
+		// Number of regions
+		int numRegions;
+		// Offsets of the rows of the elements. The size is number of elements + 1.
+		std::vector<int> offsets;
+		// Indexes of the regions containing the elements in ascending order in each row
+		std::vector<int> regions;
+	};
+
+	// Constructer
+	RegionIndex( const int numRegions, const Region* const regions );
+
+	// Destructer
+	~RegionIndex();
+
+	// Get number of regions
+	int getNumRegions() const;
+
+	// Get region
+	const Region& getRegion( const int iRegion ) const;
+
+	// Find regions containing the specified point
+	// [note] : Indexes of the regions are appended to the array in ascending order
+	void findRegionsContainingPoint( const double x, const double y, const double z, std::vector<int>& regionsFound ) const;
+
+private:
+
+	// Copy constructer
+	RegionIndex(const RegionIndex& rhs);
+
+	// Copy assignment operator
+	RegionIndex& operator=(const RegionIndex& rhs);
+
+	// Node of the hierarchy
+	struct Node{
+		// Bounding box of the regions under this node
+		CommonParameters::BoundingBox box;
+		// Index of the first child node. Negative for leaf nodes.
+		int firstChild;
+		// Range of the regions of leaf nodes in the sorted array
+		int begin;
+		int end;
+	};
+
+	// Maximum number of regions in a leaf node
+	static const int m_maxNumRegionsInLeaf = 4;
+
+	// Number of regions
+	int m_numRegions;
+
+	// Pointer to the array of regions
+	const Region* m_regions;
+
+	// Bounding boxes of the regions
+	std::vector<CommonParameters::BoundingBox> m_boxes;
+
+	// Indexes of the regions sorted so that the regions of each leaf node are contiguous
+	std::vector<int> m_sortedRegions;
+
+	// Nodes of the hierarchy. The two children of a node are stored next to each other.
+	std::vector<Node> m_nodes;
+
+	// Build the hierarchy for the specified range of the sorted regions
+	void buildNode( const int iNode, const int begin, const int end );
+
+};
+
+#endif
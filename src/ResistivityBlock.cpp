@@ -22,6 +22,9 @@
 // SOFTWARE.
 //--------------------------------------------------------------------------
 #include "ResistivityBlock.h"
+#include "PerformanceReport.h"
+#include "ProgressReporter.h"
+#include "Tracer.h"
 #include <stdlib.h>
 #include <stddef.h>
 #include <string.h>
@@ -30,6 +33,7 @@
 #include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <algorithm>
 
 // Constructer
 ResistivityBlock::ResistivityBlock(){
@@ -43,18 +47,22 @@ ResistivityBlock::~ResistivityBlock(){
 void ResistivityBlock::changeResistivityOfSelectedElements( const std::set<int>& elementsSelected, const double resistivityMod,
 														   const double resistivityModMin, const double resistivityMax ){
 
+	PerformanceReport::Timer timer(PerformanceReport::MODIFICATION);
+
 	std::set<int> elementsSelectedMod = elementsSelected;
 	const int nBlkOrg = getNumResistivityBlockTotal();
+
+	// Count the selected elements of each resistivity block
+	std::vector<int> numElementsSelected( nBlkOrg, 0 );
+	for( std::set<int>::const_iterator itr = elementsSelected.begin(); itr != elementsSelected.end(); ++itr ){
+		++numElementsSelected[ getBlockFromElement(*itr) ];
+	}
+
 	for( int iBlk = 0; iBlk < nBlkOrg; ++iBlk ){
-		const std::set<int> elements = getElementsFromBlock(iBlk);
-		bool allElementsSelected(true);
-		for( std::set<int>::const_iterator itr = elements.begin(); itr != elements.end(); ++itr ){
-			if( elementsSelected.find(*itr) == elementsSelected.end() ){
-				allElementsSelected = false;
-				break;
-			}
-		}
+		const std::set<int>& elements = getElementsFromBlock(iBlk);
+		const bool allElementsSelected = numElementsSelected[iBlk] == static_cast<int>( elements.size() );
 		if(allElementsSelected){
+			PerformanceReport::addCount(PerformanceReport::BLOCKS_FULLY_FIXED, 1);
 			ResistivityBlockInformation& info = m_resistivityBlockInfo[iBlk];
 			info.resistivityValue = resistivityMod;
 			info.resistivityValueMin = resistivityModMin;
@@ -84,12 +92,15 @@ void ResistivityBlock::changeResistivityOfSelectedElements( const std::set<int>&
 		setBuf.insert(iElem);
 		m_blockToElements.push_back(setBuf);
 	}
+	PerformanceReport::addCount(PerformanceReport::BLOCKS_CREATED, iBlk - nBlkOrg);
 
 }
 
 // Read data of resisitivity block model from input file
 void ResistivityBlock::inputResisitivityBlock(const int iterNum){
 
+	PerformanceReport::Timer timer(PerformanceReport::BLOCK_INPUT);
+
 	std::ostringstream inputFile;
 	inputFile << "resistivity_block_iter" << iterNum << ".dat";
 	std::ifstream inFile( inputFile.str().c_str(), std::ios::in );
@@ -99,6 +110,8 @@ void ResistivityBlock::inputResisitivityBlock(const int iterNum){
 		std::cerr << "File open error : " << inputFile.str().c_str() << " !!" << std::endl;
 		exit(1);
 	}
+	PerformanceReport::addSizeOfFile(PerformanceReport::BYTES_OF_INPUT_FILES, inputFile.str());
+	ProgressReporter progress(inputFile.str());
 
 	int nElem(0);
 	inFile >> nElem;
@@ -112,6 +125,7 @@ void ResistivityBlock::inputResisitivityBlock(const int iterNum){
 #endif
 	
 	for( int iElem = 0; iElem < nElem; ++iElem ){
+		progress.update( inFile, "elements", iElem );
 		int idum(0);
 		int iBlk(0);// Resistivity block ID
 		inFile >> idum >> iBlk;
@@ -130,6 +144,7 @@ void ResistivityBlock::inputResisitivityBlock(const int iterNum){
 	}
 	
 	for( int iBlk = 0; iBlk < nBlk; ++iBlk ){
+		progress.update( inFile, "blocks", iBlk );
 		int idum(0);
 		ResistivityBlockInformation info;
 		inFile >> idum;
@@ -150,6 +165,7 @@ void ResistivityBlock::inputResisitivityBlock(const int iterNum){
 	//	exit(1);
 	//}
 	inFile.close();
+	progress.finish();
 
 	m_blockToElements.reserve(nBlk);
 	for( int iBlk = 0; iBlk < nBlk; ++iBlk ){
@@ -172,6 +188,14 @@ void ResistivityBlock::inputResisitivityBlock(const int iterNum){
 
 }
 
+// Copy data of resisitivity block model from another model
+void ResistivityBlock::copyResisitivityBlock( const ResistivityBlock& resistivityBlock ){
+	m_elementToBlocks = resistivityBlock.m_elementToBlocks;
+	m_blockToElements = resistivityBlock.m_blockToElements;
+	m_resistivityBlockInfo = resistivityBlock.m_resistivityBlockInfo;
+	m_boundingBoxOfBlocks = resistivityBlock.m_boundingBoxOfBlocks;
+}
+
 int ResistivityBlock::getBlockFromElement( const int iElem ) const{
 	std::map<int, int>::const_iterator itr = m_elementToBlocks.find(iElem);
 	if( itr == m_elementToBlocks.end() ){
@@ -189,6 +213,13 @@ double ResistivityBlock::getResistivityValueFromBlockIndex( const int iBlk ) con
 	return info.resistivityValue;
 }
 
+// Get information of a resistivity block
+const ResistivityBlock::ResistivityBlockInformation& ResistivityBlock::getResistivityBlockInformation( const int iBlk ) const{
+	assert( iBlk >= 0 );
+	assert( iBlk < static_cast<int>(m_resistivityBlockInfo.size()) );
+	return m_resistivityBlockInfo[iBlk];
+}
+
 // Get total number of resistivity blocks
 int ResistivityBlock::getNumResistivityBlockTotal() const{
 	return static_cast<int>(m_resistivityBlockInfo.size());
@@ -217,15 +248,52 @@ bool ResistivityBlock::isFixedResistivityValue( const int iBlk ) const{
 }
 
 // Get element indexes from resistivity block index
-const std::set<int> ResistivityBlock::getElementsFromBlock( const int iBlk ) const{
+const std::set<int>& ResistivityBlock::getElementsFromBlock( const int iBlk ) const{
 	return m_blockToElements[iBlk];
 }
 
+// Calculate bounding boxes of the centers of the elements belonging to each resistivity block
+void ResistivityBlock::calcBoundingBoxesOfBlocks( const MeshData* const MeshData ){
+
+	PerformanceReport::Timer timer(PerformanceReport::PREPROCESSING);
+
+	const int nBlk = static_cast<int>( m_blockToElements.size() );
+	m_boundingBoxOfBlocks.resize(nBlk);
+#pragma omp parallel for schedule(dynamic, 64)
+	for( int iBlk = 0; iBlk < nBlk; ++iBlk ){
+		CommonParameters::BoundingBox& box = m_boundingBoxOfBlocks[iBlk];
+		// Bounding box of a block without elements is left empty ( minimum > maximum )
+		box.minCoord.X = box.minCoord.Y = box.minCoord.Z = 1.0e+99;
+		box.maxCoord.X = box.maxCoord.Y = box.maxCoord.Z = -1.0e+99;
+		const std::set<int>& elements = m_blockToElements[iBlk];
+		for( std::set<int>::const_iterator itr = elements.begin(); itr != elements.end(); ++itr ){
+			const CommonParameters::locationXYZ center = MeshData->getElementCenter(*itr);
+			box.minCoord.X = std::min( box.minCoord.X, center.X );
+			box.minCoord.Y = std::min( box.minCoord.Y, center.Y );
+			box.minCoord.Z = std::min( box.minCoord.Z, center.Z );
+			box.maxCoord.X = std::max( box.maxCoord.X, center.X );
+			box.maxCoord.Y = std::max( box.maxCoord.Y, center.Y );
+			box.maxCoord.Z = std::max( box.maxCoord.Z, center.Z );
+		}
+	}
+
+}
+
+// Get bounding box of the centers of the elements belonging to a resistivity block
+const CommonParameters::BoundingBox& ResistivityBlock::getBoundingBoxOfBlock( const int iBlk ) const{
+	assert( iBlk >= 0 );
+	assert( iBlk < static_cast<int>(m_boundingBoxOfBlocks.size()) );
+	return m_boundingBoxOfBlocks[iBlk];
+}
+
 // Output data of resisitivity block model to file
 void ResistivityBlock::outputResisitivityBlock( const MeshData* const MeshData, const int iterNum ) const{
 
+	PerformanceReport::Timer timer(PerformanceReport::OUTPUT);
+
 	std::ostringstream fileName;
 	fileName << "resistivity_block_iter" << iterNum << ".mod.dat";
+	Tracer::Event event("output", fileName.str());
 
 	FILE *fp;
 	if( (fp = fopen( fileName.str().c_str(), "w")) == NULL ) {
@@ -250,14 +318,18 @@ void ResistivityBlock::outputResisitivityBlock( const MeshData* const MeshData,
 	}
 	
 	fclose(fp);
+	PerformanceReport::addSizeOfFile(PerformanceReport::BYTES_WRITTEN, fileName.str());
 
 }
 
 // Output resistivity values to binary file
 void ResistivityBlock::outputResistivityValuesToBinary( const bool isTetra, const MeshData* const MeshData, const int iterNum ) const{
 
+	PerformanceReport::Timer timer(PerformanceReport::OUTPUT);
+
 	std::ostringstream oss;
 	oss << "ResistivityMod.iter" << iterNum;
+	Tracer::Event event("output", oss.str());
 	std::ofstream fout;
 	fout.open( oss.str().c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
 
@@ -289,5 +361,27 @@ void ResistivityBlock::outputResistivityValuesToBinary( const bool isTetra, cons
 	}
 
 	fout.close();
+	PerformanceReport::addSizeOfFile(PerformanceReport::BYTES_WRITTEN, oss.str());
+
+}
+
+// Add allocated bytes of the containers to the performance report
+void ResistivityBlock::addMemoryUsageToReport( const std::string& prefix ) const{
+
+	PerformanceReport::addMemoryUsage( prefix + ".element_to_block", static_cast<long long>( m_elementToBlocks.size() )
+		* PerformanceReport::calcTreeNodeSize( static_cast<long long>( sizeof(std::map<int, int>::value_type) ) ) );
+
+	long long bytes = PerformanceReport::calcHeapBlockSize( static_cast<long long>( m_blockToElements.capacity() * sizeof(std::set<int>) ) );
+	const long long bytesOfNode = PerformanceReport::calcTreeNodeSize( static_cast<long long>( sizeof(int) ) );
+	for( std::vector< std::set<int> >::const_iterator itr = m_blockToElements.begin(); itr != m_blockToElements.end(); ++itr ){
+		bytes += static_cast<long long>( itr->size() ) * bytesOfNode;
+	}
+	PerformanceReport::addMemoryUsage( prefix + ".block_to_elements", bytes );
+
+	PerformanceReport::addMemoryUsage( prefix + ".block_information",
+		PerformanceReport::calcHeapBlockSize( static_cast<long long>( m_resistivityBlockInfo.capacity() * sizeof(ResistivityBlockInformation) ) ) );
+
+	PerformanceReport::addMemoryUsage( prefix + ".bounding_boxes",
+		PerformanceReport::calcHeapBlockSize( static_cast<long long>( m_boundingBoxOfBlocks.capacity() * sizeof(CommonParameters::BoundingBox) ) ) );
 
 }
@@ -69,12 +69,18 @@ public:
 	// Read data of resisitivity block model from input file
 	void inputResisitivityBlock(const int iterNum);
 
+	// Copy data of resisitivity block model from another model
+	void copyResisitivityBlock( const ResistivityBlock& resistivityBlock );
+
 	// Get resisitivity block index from element index
 	int getBlockFromElement( const int iElem ) const;
 
 	// Get resistivity value from resisitivity block index
 	double getResistivityValueFromBlockIndex( const int iBlk ) const;
 
+	// Get information of a resistivity block
+	const ResistivityBlockInformation& getResistivityBlockInformation( const int iBlk ) const;
+
 	// Get total number of resistivity blocks
 	int getNumResistivityBlockTotal() const;
 
@@ -82,7 +88,13 @@ public:
 	bool isFixedResistivityValue( const int iBlk ) const;
 
 	// Get element indexes from resistivity block index
-	const std::set<int> getElementsFromBlock( const int iBlk ) const;
+	const std::set<int>& getElementsFromBlock( const int iBlk ) const;
+
+	// Calculate bounding boxes of the centers of the elements belonging to each resistivity block
+	void calcBoundingBoxesOfBlocks( const MeshData* const MeshData );
+
+	// Get bounding box of the centers of the elements belonging to a resistivity block
+	const CommonParameters::BoundingBox& getBoundingBoxOfBlock( const int iBlk ) const;
 
 	// Output data of resisitivity block model to file
 	void outputResisitivityBlock( const MeshData* const MeshData, const int iterNum ) const;
@@ -90,8 +102,12 @@ public:
 	// Output resistivity values to binary file
 	void outputResistivityValuesToBinary( const bool isTetra, const MeshData* const MeshData, const int iterNum ) const;
 
+	// Add allocated bytes of the containers to the performance report
+	void addMemoryUsageToReport( const std::string& prefix ) const;
+
 private:
 	// Copy constructer
+	// [note] : Use ResistivityBlockOverlay to hold modified copies sharing this model
 	ResistivityBlock(const ResistivityBlock& rhs){
 		std::cerr << "Error : Copy constructer of the class ResistivityBlock is not implemented." << std::endl;
 		exit(1);
@@ -112,6 +128,9 @@ private:
 	// Arrays of resistivity block information
 	std::vector<ResistivityBlockInformation> m_resistivityBlockInfo;
 
+	// Bounding boxes of the centers of the elements belonging to each resistivity block
+	std::vector<CommonParameters::BoundingBox> m_boundingBoxOfBlocks;
+
 };
 
 #endif
@@ -0,0 +1,275 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include "ResistivityBlockOverlay.h"
+#include "PerformanceReport.h"
+#include "Tracer.h"
+
+// Constructer
+ResistivityBlockOverlay::ResistivityBlockOverlay( const ResistivityBlock* const ptrBase ):
+	m_ptrBase(ptrBase)
+{
+}
+
+// Destructer
+ResistivityBlockOverlay::~ResistivityBlockOverlay(){
+}
+
+// Copy constructer
+ResistivityBlockOverlay::ResistivityBlockOverlay(const ResistivityBlockOverlay& rhs):
+	m_ptrBase(rhs.m_ptrBase),
+	m_changedElementToBlocks(rhs.m_changedElementToBlocks),
+	m_changedBlockInfo(rhs.m_changedBlockInfo),
+	m_appendedBlockInfo(rhs.m_appendedBlockInfo)
+{
+}
+
+// Assignment operator
+ResistivityBlockOverlay& ResistivityBlockOverlay::operator=(const ResistivityBlockOverlay& rhs){
+	if( this == &rhs ){
+		return *this;
+	}
+	m_ptrBase = rhs.m_ptrBase;
+	m_changedElementToBlocks = rhs.m_changedElementToBlocks;
+	m_changedBlockInfo = rhs.m_changedBlockInfo;
+	m_appendedBlockInfo = rhs.m_appendedBlockInfo;
+	return *this;
+}
+
+// Discard all changes from the base model
+void ResistivityBlockOverlay::clear(){
+	m_changedElementToBlocks.clear();
+	m_changedBlockInfo.clear();
+	m_appendedBlockInfo.clear();
+}
+
+// Get pointer to the base resistivity block model
+const ResistivityBlock* ResistivityBlockOverlay::getBaseResistivityBlock() const{
+	return m_ptrBase;
+}
+
+// Get number of elements whose resistivity blocks are changed from the base model
+int ResistivityBlockOverlay::getNumChangedElements() const{
+	return static_cast<int>( m_changedElementToBlocks.size() );
+}
+
+// Change resistivity of the selected elements
+// The result is the same as that of ResistivityBlock::changeResistivityOfSelectedElements applied to the base model
+void ResistivityBlockOverlay::changeResistivityOfSelectedElements( const std::set<int>& elementsSelected, const double resistivityMod,
+	const double resistivityModMin, const double resistivityMax ){
+
+	PerformanceReport::Timer timer(PerformanceReport::MODIFICATION);
+
+	const int nBlkOrg = getNumResistivityBlockTotal();
+	const int nBlkBase = m_ptrBase->getNumResistivityBlockTotal();
+
+	std::vector<int> numElements;
+	calcNumElementsOfBlocks( numElements );
+
+	// Count the selected elements of each resistivity block
+	std::vector<int> numElementsSelected( nBlkOrg, 0 );
+	for( std::set<int>::const_iterator itr = elementsSelected.begin(); itr != elementsSelected.end(); ++itr ){
+		++numElementsSelected[ getBlockFromElement(*itr) ];
+	}
+
+	// Resistivity blocks all of whose elements are selected are changed
+	std::vector<unsigned char> allElementsSelected( nBlkOrg, 0 );
+	int numBlocksFullyFixed(0);
+	for( int iBlk = 0; iBlk < nBlkOrg; ++iBlk ){
+		if( numElementsSelected[iBlk] != numElements[iBlk] ){
+			continue;
+		}
+		allElementsSelected[iBlk] = 1;
+		++numBlocksFullyFixed;
+		ResistivityBlock::ResistivityBlockInformation info = getResistivityBlockInformation(iBlk);
+		info.resistivityValue = resistivityMod;
+		info.resistivityValueMin = resistivityModMin;
+		info.resistivityValueMax = resistivityMax;
+		info.type = ResistivityBlock::FIXED_AND_ISOLATED;
+		if( iBlk < nBlkBase ){
+			m_changedBlockInfo[iBlk] = info;
+		}else{
+			m_appendedBlockInfo[ iBlk - nBlkBase ] = info;
+		}
+	}
+
+	// New resistivity block is appended for each of the other selected elements
+	int iBlk(nBlkOrg);
+	for( std::set<int>::const_iterator itr = elementsSelected.begin(); itr != elementsSelected.end(); ++itr ){
+		const int iElem = *itr;
+		const int iBlkOrg = getBlockFromElement(iElem);
+		if( allElementsSelected[iBlkOrg] != 0 ){
+			continue;
+		}
+		ResistivityBlock::ResistivityBlockInformation info;
+		info.resistivityValue = resistivityMod;
+		info.resistivityValueMin = resistivityModMin;
+		info.resistivityValueMax = resistivityMax;
+		info.type = ResistivityBlock::FIXED_AND_ISOLATED;
+		info.weightingConstant = getResistivityBlockInformation(iBlkOrg).weightingConstant;
+		m_appendedBlockInfo.push_back(info);
+		m_changedElementToBlocks[iElem] = iBlk;
+		++iBlk;
+	}
+
+	PerformanceReport::addCount(PerformanceReport::BLOCKS_FULLY_FIXED, numBlocksFullyFixed);
+	PerformanceReport::addCount(PerformanceReport::BLOCKS_CREATED, iBlk - nBlkOrg);
+
+}
+
+// Get resisitivity block index from element index
+int ResistivityBlockOverlay::getBlockFromElement( const int iElem ) const{
+	std::map<int, int>::const_iterator itr = m_changedElementToBlocks.find(iElem);
+	if( itr != m_changedElementToBlocks.end() ){
+		return itr->second;
+	}
+	return m_ptrBase->getBlockFromElement(iElem);
+}
+
+// Get information of a resistivity block
+const ResistivityBlock::ResistivityBlockInformation& ResistivityBlockOverlay::getResistivityBlockInformation( const int iBlk ) const{
+	assert( iBlk >= 0 );
+	assert( iBlk < getNumResistivityBlockTotal() );
+	const int nBlkBase = m_ptrBase->getNumResistivityBlockTotal();
+	if( iBlk >= nBlkBase ){
+		return m_appendedBlockInfo[ iBlk - nBlkBase ];
+	}
+	std::map<int, ResistivityBlock::ResistivityBlockInformation>::const_iterator itr = m_changedBlockInfo.find(iBlk);
+	if( itr != m_changedBlockInfo.end() ){
+		return itr->second;
+	}
+	return m_ptrBase->getResistivityBlockInformation(iBlk);
+}
+
+// Get total number of resistivity blocks
+int ResistivityBlockOverlay::getNumResistivityBlockTotal() const{
+	return m_ptrBase->getNumResistivityBlockTotal() + static_cast<int>( m_appendedBlockInfo.size() );
+}
+
+// Output data of resisitivity block model to file
+void ResistivityBlockOverlay::outputResisitivityBlock( const MeshData* const MeshData, const int iterNum, const std::string& prefix ) const{
+	outputResisitivityBlock( MeshData->getNumElemTotal(), iterNum, prefix );
+}
+
+// Output data of resisitivity block model to file without mesh data
+void ResistivityBlockOverlay::outputResisitivityBlock( const int numElems, const int iterNum, const std::string& prefix ) const{
+
+	PerformanceReport::Timer timer(PerformanceReport::OUTPUT);
+
+	std::ostringstream fileName;
+	fileName << prefix << "resistivity_block_iter" << iterNum << ".mod.dat";
+	Tracer::Event event("output", fileName.str());
+
+	FILE *fp;
+	if( (fp = fopen( fileName.str().c_str(), "w")) == NULL ) {
+		std::cerr  << "File open error !! : " << fileName.str() << std::endl;
+		exit(1);
+	}
+
+	const int numBlocks = getNumResistivityBlockTotal();
+	fprintf(fp, "%10d%10d\n",numElems, numBlocks );
+	for( int iElem = 0; iElem < numElems; ++iElem ){
+		fprintf(fp, "%10d%10d\n", iElem, getBlockFromElement(iElem) );
+	}
+	for( int iBlk = 0; iBlk < numBlocks; ++iBlk ){
+		const ResistivityBlock::ResistivityBlockInformation& info = getResistivityBlockInformation(iBlk);
+		fprintf(fp, "%10d%5s%15e%15e%15e%15e%10d\n", iBlk, "     ",
+			info.resistivityValue, 
+			info.resistivityValueMin,
+			info.resistivityValueMax,
+			info.weightingConstant,
+			info.type);
+	}
+	
+	fclose(fp);
+	PerformanceReport::addSizeOfFile(PerformanceReport::BYTES_WRITTEN, fileName.str());
+
+}
+
+// Output resistivity values to binary file
+void ResistivityBlockOverlay::outputResistivityValuesToBinary( const bool isTetra, const MeshData* const MeshData, const int iterNum, const std::string& prefix ) const{
+	outputResistivityValuesToBinary( isTetra, MeshData->getNumElemTotal(), iterNum, prefix );
+}
+
+// Output resistivity values to binary file without mesh data
+void ResistivityBlockOverlay::outputResistivityValuesToBinary( const bool isTetra, const int numElems, const int iterNum, const std::string& prefix ) const{
+
+	PerformanceReport::Timer timer(PerformanceReport::OUTPUT);
+
+	std::ostringstream oss;
+	oss << prefix << "ResistivityMod.iter" << iterNum;
+	Tracer::Event event("output", oss.str());
+	std::ofstream fout;
+	fout.open( oss.str().c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+
+	char line[80];
+	std::ostringstream ossTitle;
+	ossTitle << "Resistivity[Ohm-m]";
+	strcpy( line, ossTitle.str().c_str() );
+	fout.write( line, 80 );
+
+	strcpy( line, "part" );
+	fout.write( line, 80 );
+
+	int ibuf(1);
+	fout.write( (char*) &ibuf, sizeof( int ) );
+
+	if(isTetra){
+		strcpy( line, "tetra4" );
+	}else{
+		strcpy( line, "hexa8" );
+	}
+	fout.write( line, 80 );
+
+	for( int iElem = 0 ; iElem < numElems; ++iElem ){
+		const ResistivityBlock::ResistivityBlockInformation& info = getResistivityBlockInformation( getBlockFromElement(iElem) );
+		float dbuf = static_cast<float>(info.resistivityValue);
+		fout.write( (char*) &dbuf, sizeof( float ) );
+	}
+
+	fout.close();
+	PerformanceReport::addSizeOfFile(PerformanceReport::BYTES_WRITTEN, oss.str());
+
+}
+
+// Calculate number of elements belonging to each resistivity block
+void ResistivityBlockOverlay::calcNumElementsOfBlocks( std::vector<int>& numElements ) const{
+
+	const int nBlkBase = m_ptrBase->getNumResistivityBlockTotal();
+	numElements.assign( getNumResistivityBlockTotal(), 0 );
+	for( int iBlk = 0; iBlk < nBlkBase; ++iBlk ){
+		numElements[iBlk] = static_cast<int>( m_ptrBase->getElementsFromBlock(iBlk).size() );
+	}
+	for( std::map<int, int>::const_iterator itr = m_changedElementToBlocks.begin(); itr != m_changedElementToBlocks.end(); ++itr ){
+		--numElements[ m_ptrBase->getBlockFromElement(itr->first) ];
+		++numElements[ itr->second ];
+	}
+
+}
@@ -0,0 +1,107 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#ifndef DBLDEF_RESISTIVITY_BLOCK_OVERLAY
+#define DBLDEF_RESISTIVITY_BLOCK_OVERLAY
+
+#include <set>
+#include <map>
+#include <vector>
+#include <string>
+#include "MeshData.h"
+#include "ResistivityBlock.h"
+
+// Class of resistivity block model modified from a base model which is not changed
+// Only the changed element-to-block entries and the changed or appended blocks are held,
+// so that many modified models can share one base model.
+// [note] : Copying an overlay is cheap and gives an independent snapshot of the modified model.
+class ResistivityBlockOverlay{
+
+public:
+
+	// Constructer
+	explicit ResistivityBlockOverlay( const ResistivityBlock* const ptrBase );
+
+	// Destructer
+	~ResistivityBlockOverlay();
+
+	// Copy constructer
+	ResistivityBlockOverlay(const ResistivityBlockOverlay& rhs);
+
+	// Copy assignment operator
+	ResistivityBlockOverlay& operator=(const ResistivityBlockOverlay& rhs);
+
+	// Discard all changes from the base model
+	void clear();
+
+	// Get pointer to the base resistivity block model
+	const ResistivityBlock* getBaseResistivityBlock() const;
+
+	// Get number of elements whose resistivity blocks are changed from the base model
+	int getNumChangedElements() const;
+
+	// Change resistivity of the selected elements
+	void changeResistivityOfSelectedElements( const std::set<int>& elementsSelected, const double resistivityMod,
+		const double resistivityModMin, const double resistivityMax );
+
+	// Get resisitivity block index from element index
+	int getBlockFromElement( const int iElem ) const;
+
+	// Get information of a resistivity block
+	const ResistivityBlock::ResistivityBlockInformation& getResistivityBlockInformation( const int iBlk ) const;
+
+	// Get total number of resistivity blocks
+	int getNumResistivityBlockTotal() const;
+
+	// Output data of resisitivity block model to file
+	void outputResisitivityBlock( const MeshData* const MeshData, const int iterNum, const std::string& prefix ) const;
+
+	// Output data of resisitivity block model to file without mesh data
+	void outputResisitivityBlock( const int numElems, const int iterNum, const std::string& prefix ) const;
+
+	// Output resistivity values to binary file
+	void outputResistivityValuesToBinary( const bool isTetra, const MeshData* const MeshData, const int iterNum, const std::string& prefix ) const;
+
+	// Output resistivity values to binary file without mesh data
+	void outputResistivityValuesToBinary( const bool isTetra, const int numElems, const int iterNum, const std::string& prefix ) const;
+
+private:
+
+	// Pointer to the base resistivity block model
+	const ResistivityBlock* m_ptrBase;
+
+	// Array mapping the changed element indexes to resistivity block indexes
+	std::map<int, int> m_changedElementToBlocks;
+
+	// Information of the resistivity blocks of the base model which are changed
+	std::map<int, ResistivityBlock::ResistivityBlockInformation> m_changedBlockInfo;
+
+	// Information of the resistivity blocks appended to the base model
+	std::vector<ResistivityBlock::ResistivityBlockInformation> m_appendedBlockInfo;
+
+	// Calculate number of elements belonging to each resistivity block
+	void calcNumElementsOfBlocks( std::vector<int>& numElements ) const;
+
+};
+
+#endif
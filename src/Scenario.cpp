@@ -0,0 +1,202 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#include <iostream>
+#include <set>
+#include <stdlib.h>
+
+#include "Scenario.h"
+#include "ResistivityBlockOverlay.h"
+#include "Verifier.h"
+#include "PerformanceReport.h"
+
+// Constructer
+Scenario::Scenario():
+	m_outputPrefix(""),
+	m_ptrRegion(NULL),
+	m_modifiedResistivity(-1.0),
+	m_modifiedMinResistivity(0.1),
+	m_modifiedMaxResistivity(1.0e4)
+{
+	m_selectionParameters.selectionMode = ElementSelector::CENTER_OF_ELEMENT;
+	m_selectionParameters.numGaussPoints = 2;
+	m_selectionParameters.thresholdVolumeFraction = 0.5;
+	m_selectionParameters.resistivityMin = 0.1;
+	m_selectionParameters.resistivityMax = 1.0e4;
+}
+
+// Destructer
+Scenario::~Scenario(){
+
+	if( m_ptrRegion != NULL ){
+		delete m_ptrRegion;
+		m_ptrRegion = NULL;
+	}
+
+}
+
+// Copy constructer
+Scenario::Scenario(const Scenario& rhs){
+	std::cerr << "Error : Copy constructer of the class Scenario is not implemented." << std::endl;
+	exit(1);
+}
+
+// Assignment operator
+Scenario& Scenario::operator=(const Scenario& rhs){
+	std::cerr << "Error : Assignment operator of the class Scenario is not implemented." << std::endl;
+	exit(1);
+}
+
+// Read parameters of the scenario
+void Scenario::readParameters( std::istream& ifs, const bool isBatchMode ){
+
+	if( isBatchMode ){
+		ifs >> m_outputPrefix;
+		std::cout << "Prefix of output files : " << m_outputPrefix << std::endl;
+	}
+
+	if( m_ptrRegion != NULL ){
+		delete m_ptrRegion;
+	}
+	m_ptrRegion = Region::createRegion(ifs);
+
+	ifs >> m_selectionParameters.resistivityMin;
+	std::cout << "Minimum resistivity for selecting parameter cells [Ohm-m] :  " << m_selectionParameters.resistivityMin << std::endl;
+	ifs >> m_selectionParameters.resistivityMax;
+	std::cout << "Maximum resistivity for selecting parameter cells [Ohm-m] :  " << m_selectionParameters.resistivityMax << std::endl;
+
+	ifs >> m_modifiedResistivity;
+	std::cout << "Modified resistivity [Ohm-m] :  " << m_modifiedResistivity << std::endl;
+	ifs >> m_modifiedMinResistivity;
+	std::cout << "Modified minimum resistivity [Ohm-m] :  " << m_modifiedMinResistivity << std::endl;
+	ifs >> m_modifiedMaxResistivity;
+	std::cout << "Modified maximum resistivity [Ohm-m] :  " << m_modifiedMaxResistivity << std::endl;
+
+	// Parameters of the selection criterion, which are optional for a single scenario
+	int ibuf(ElementSelector::CENTER_OF_ELEMENT);
+	if( isBatchMode ){
+		ifs >> ibuf;
+		m_selectionParameters.selectionMode = ibuf;
+	}else if( ifs >> ibuf ){
+		m_selectionParameters.selectionMode = ibuf;
+	}
+	switch (m_selectionParameters.selectionMode){
+		case ElementSelector::CENTER_OF_ELEMENT:
+			std::cout << "Selection mode : Center of element" << std::endl;
+			break;
+		case ElementSelector::VOLUME_FRACTION:
+			std::cout << "Selection mode : Volume fraction" << std::endl;
+			ifs >> m_selectionParameters.numGaussPoints;
+			std::cout << "Number of Gauss points along each direction : " << m_selectionParameters.numGaussPoints << std::endl;
+			if( m_selectionParameters.numGaussPoints < 1 || m_selectionParameters.numGaussPoints > 3 ){
+				std::cerr << "Number of Gauss points must be 1, 2 or 3 !!" << std::endl;
+				exit(1);
+			}
+			ifs >> m_selectionParameters.thresholdVolumeFraction;
+			std::cout << "Threshold of volume fraction : " << m_selectionParameters.thresholdVolumeFraction << std::endl;
+			break;
+		default:
+			std::cout << "Selection mode is wrong : " << m_selectionParameters.selectionMode << std::endl;
+			exit(1);
+	}
+
+}
+
+// Get parameters of the selection
+const ElementSelector::SelectionParameters& Scenario::getSelectionParameters() const{
+	return m_selectionParameters;
+}
+
+// Get prefix of the output files
+const std::string& Scenario::getOutputPrefix() const{
+	return m_outputPrefix;
+}
+
+// Write parameters determining the selected elements in canonical form
+void Scenario::writeCanonicalSelectionParameters( std::ostream& ofs ) const{
+
+	const std::streamsize precisionOrg = ofs.precision(17);
+	ofs << "SELECTION " << m_selectionParameters.selectionMode;
+	if( m_selectionParameters.selectionMode == ElementSelector::VOLUME_FRACTION ){
+		ofs << " " << m_selectionParameters.numGaussPoints << " " << m_selectionParameters.thresholdVolumeFraction;
+	}
+	ofs << std::endl;
+	ofs << "RANGE " << m_selectionParameters.resistivityMin << " " << m_selectionParameters.resistivityMax << std::endl;
+	ofs.precision(precisionOrg);
+	m_ptrRegion->writeCanonicalParameters(ofs);
+
+}
+
+// Select elements of the scenario
+void Scenario::selectElements( const ResistivityBlock& resistivityBlock, const ElementSelector& selector,
+	const ElementSelector::Eligibility& eligibility, std::set<int>& elementsSelected ) const{
+	selector.selectElements(resistivityBlock, *m_ptrRegion, m_selectionParameters, eligibility, elementsSelected);
+}
+
+// Change resistivity of the selected elements and output the modified model
+void Scenario::modifyResistivity( const bool isTetra, const int numElems, const ResistivityBlock& resistivityBlock,
+	const std::set<int>& elementsSelected, const int iterNum, std::ostream& ofsLog ) const{
+
+	ofsLog << "Number of the selected elements : " << elementsSelected.size() << std::endl;
+
+	ResistivityBlockOverlay resistivityBlockMod(&resistivityBlock);
+	resistivityBlockMod.changeResistivityOfSelectedElements(elementsSelected, m_modifiedResistivity, m_modifiedMinResistivity, m_modifiedMaxResistivity);
+	resistivityBlockMod.outputResisitivityBlock(numElems, iterNum, m_outputPrefix);
+	resistivityBlockMod.outputResistivityValuesToBinary(isTetra, numElems, iterNum, m_outputPrefix);
+
+}
+
+// Verify the selected elements and the modified model against the serial reference implementations
+bool Scenario::verify( const bool isTetra, const int numElems, const ResistivityBlock& resistivityBlock, const ElementSelector& selector,
+	const std::set<int>& elementsSelected, const int iterNum, std::ostream& ofsLog ) const{
+
+	PerformanceReport::Timer timer(PerformanceReport::VERIFICATION);
+
+	if( m_selectionParameters.selectionMode == ElementSelector::VOLUME_FRACTION ){
+		ofsLog << "Volume fractions are calculated by the same function in the reference implementation and are not verified" << std::endl;
+	}
+	std::set<int> elementsReference;
+	selector.selectElementsReference(resistivityBlock, *m_ptrRegion, m_selectionParameters, elementsReference);
+	const bool isSelectionVerified = Verifier::compareSelectedElements(elementsReference, elementsSelected, ofsLog);
+
+	// The output files written by modifyResistivity are compared
+	const bool isModelVerified = Verifier::verifyOutputFiles(isTetra, numElems, iterNum, m_outputPrefix, resistivityBlock, elementsReference,
+		m_modifiedResistivity, m_modifiedMinResistivity, m_modifiedMaxResistivity, ofsLog);
+
+	if( isSelectionVerified && isModelVerified ){
+		ofsLog << "Verification against the reference implementation passed" << std::endl;
+		return true;
+	}
+	return false;
+
+}
+
+// Select elements, change their resistivity and output the modified model
+void Scenario::execute( const bool isTetra, const MeshData* const ptrMeshData, const ResistivityBlock& resistivityBlock,
+	const ElementSelector& selector, const ElementSelector::Eligibility& eligibility, const int iterNum, std::ostream& ofsLog ) const{
+
+	std::set<int> elementsSelected;
+	selectElements(resistivityBlock, selector, eligibility, elementsSelected);
+	modifyResistivity(isTetra, ptrMeshData->getNumElemTotal(), resistivityBlock, elementsSelected, iterNum, ofsLog);
+
+}
@@ -0,0 +1,109 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#ifndef DBLDEF_SCENARIO
+#define DBLDEF_SCENARIO
+
+#include <iostream>
+#include <string>
+#include <set>
+#include "MeshData.h"
+#include "ResistivityBlock.h"
+#include "Region.h"
+#include "ElementSelector.h"
+
+// Class of a scenario changing resistivity of the elements in a region
+class Scenario{
+
+public:
+
+	// Constructer
+	Scenario();
+
+	// Destructer
+	~Scenario();
+
+	// Read parameters of the scenario
+	// [note] : In batch mode, the output prefix precedes the parameters and the selection mode must be specified.
+	void readParameters( std::istream& ifs, const bool isBatchMode );
+
+	// Get parameters of the selection
+	const ElementSelector::SelectionParameters& getSelectionParameters() const;
+
+	// Get prefix of the output files
+	const std::string& getOutputPrefix() const;
+
+	// Write parameters determining the selected elements in canonical form
+	void writeCanonicalSelectionParameters( std::ostream& ofs ) const;
+
+	// Select elements of the scenario
+	void selectElements( const ResistivityBlock& resistivityBlock, const ElementSelector& selector,
+		const ElementSelector::Eligibility& eligibility, std::set<int>& elementsSelected ) const;
+
+	// Change resistivity of the selected elements and output the modified model
+	// [note] : Mesh data are not required because only the number of elements is used
+	void modifyResistivity( const bool isTetra, const int numElems, const ResistivityBlock& resistivityBlock,
+		const std::set<int>& elementsSelected, const int iterNum, std::ostream& ofsLog ) const;
+
+	// Verify the selected elements and the output files of the modified model against the serial reference implementations
+	// [note] : The reference model is made from the elements selected by the reference implementation,
+	//          so that the whole path from the selection to the output files is verified.
+	//          The output files must have been written by modifyResistivity.
+	bool verify( const bool isTetra, const int numElems, const ResistivityBlock& resistivityBlock, const ElementSelector& selector,
+		const std::set<int>& elementsSelected, const int iterNum, std::ostream& ofsLog ) const;
+
+	// Select elements, change their resistivity and output the modified model
+	// [note] : The base resistivity block model is not changed, so that scenarios can be executed concurrently.
+	//          Messages are written to the specified stream of the scenario.
+	void execute( const bool isTetra, const MeshData* const ptrMeshData, const ResistivityBlock& resistivityBlock,
+		const ElementSelector& selector, const ElementSelector::Eligibility& eligibility, const int iterNum, std::ostream& ofsLog ) const;
+
+private:
+
+	// Copy constructer
+	Scenario(const Scenario& rhs);
+
+	// Copy assignment operator
+	Scenario& operator=(const Scenario& rhs);
+
+	// Prefix of the output files
+	std::string m_outputPrefix;
+
+	// Pointer to the region where resistivity is changed
+	Region* m_ptrRegion;
+
+	// Parameters of the selection
+	ElementSelector::SelectionParameters m_selectionParameters;
+
+	// Modified resistivity
+	double m_modifiedResistivity;
+
+	// Modified minimum resistivity
+	double m_modifiedMinResistivity;
+
+	// Modified maximum resistivity
+	double m_modifiedMaxResistivity;
+
+};
+
+#endif
@@ -0,0 +1,373 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#ifdef _LINUX
+#include <unistd.h>
+#include <errno.h>
+#include <sys/stat.h>
+#endif
+
+#include "SelectionCache.h"
+
+namespace{
+const char magicOfSelectionCache[8] = { 'F', 'E', 'M', 'T', 'I', 'C', 'S', 'C' };
+const char magicOfFileHashRecord[8] = { 'F', 'E', 'M', 'T', 'I', 'C', 'F', 'H' };
+// Parameters of the 64-bit FNV-1a hash
+const unsigned long long offsetBasisOfHash = 14695981039346656037ULL;
+const unsigned long long primeOfHash = 1099511628211ULL;
+#ifdef _LINUX
+// Number of the temporary files named in the process
+int numTemporaryFiles = 0;
+#endif
+}
+
+// Constructer
+SelectionCache::SelectionCache():
+	m_directory("."),
+	m_isWritable(true)
+{
+}
+
+// Destructer
+SelectionCache::~SelectionCache(){
+}
+
+// Copy constructer
+SelectionCache::SelectionCache(const SelectionCache& rhs){
+	std::cerr << "Error : Copy constructer of the class SelectionCache is not implemented." << std::endl;
+	exit(1);
+}
+
+// Assignment operator
+SelectionCache& SelectionCache::operator=(const SelectionCache& rhs){
+	std::cerr << "Error : Assignment operator of the class SelectionCache is not implemented." << std::endl;
+	exit(1);
+}
+
+// Set directory in which the entries are stored
+void SelectionCache::setDirectory( const std::string& directory ){
+
+	m_directory = directory;
+	m_isWritable = true;
+#ifdef _LINUX
+	struct stat status;
+	if( stat( directory.c_str(), &status ) != 0 && mkdir( directory.c_str(), 0755 ) != 0 ){
+		std::cerr << "Warning : Failed to create directory of the cache " << directory << " : " << strerror(errno) << std::endl;
+		m_isWritable = false;
+	}else if( access( directory.c_str(), W_OK | X_OK ) != 0 ){
+		std::cerr << "Warning : Directory of the cache " << directory << " is not writable" << std::endl;
+		m_isWritable = false;
+	}
+	if( !m_isWritable ){
+		std::cerr << "Warning : Selected elements are not stored in the cache" << std::endl;
+	}
+#endif
+
+}
+
+// Calculate hash value of a file
+unsigned long long SelectionCache::calcHashOfFile( const std::string& fileName ){
+
+	FILE *fp;
+	if( (fp = fopen( fileName.c_str(), "rb")) == NULL ) {
+		std::cerr  << "File open error !! : " << fileName << std::endl;
+		exit(1);
+	}
+
+	const int bufferSize = 1 << 20;
+	unsigned char* buffer = new unsigned char[bufferSize];
+	unsigned long long hash = offsetBasisOfHash;
+	size_t numRead(0);
+	while( ( numRead = fread( buffer, 1, bufferSize, fp ) ) > 0 ){
+		for( size_t i = 0; i < numRead; ++i ){
+			hash ^= buffer[i];
+			hash *= primeOfHash;
+		}
+	}
+	delete [] buffer;
+	fclose(fp);
+
+	return hash;
+
+}
+
+// Get hash value of a file
+unsigned long long SelectionCache::getHashOfFile( const std::string& fileName ) const{
+
+	FileHashRecord record;
+	if( !getFileStatus( fileName, record ) ){
+		return calcHashOfFile(fileName);
+	}
+
+	const std::string recordFileName = getFileNameOfHashRecord(record);
+	std::ifstream fin( recordFileName.c_str(), std::ios::in | std::ios::binary );
+	if( !fin.fail() ){
+		FileHashRecord recordStored;
+		fin.read( reinterpret_cast<char*>(&recordStored), sizeof(FileHashRecord) );
+		if( !fin.fail() && memcmp( recordStored.magic, magicOfFileHashRecord, sizeof(magicOfFileHashRecord) ) == 0 &&
+			recordStored.version == m_version &&
+			recordStored.device == record.device && recordStored.inode == record.inode && recordStored.size == record.size &&
+			recordStored.modificationTime == record.modificationTime && recordStored.modificationTimeNano == record.modificationTimeNano &&
+			recordStored.statusChangeTime == record.statusChangeTime && recordStored.statusChangeTimeNano == record.statusChangeTimeNano ){
+			return recordStored.hash;
+		}
+		fin.close();
+	}
+
+	record.hash = calcHashOfFile(fileName);
+
+	// The record is not stored if the file has been changed while it was read
+	FileHashRecord recordAfter;
+	if( !m_isWritable || !getFileStatus( fileName, recordAfter ) || recordAfter.size != record.size ||
+		recordAfter.modificationTime != record.modificationTime || recordAfter.modificationTimeNano != record.modificationTimeNano ||
+		recordAfter.statusChangeTime != record.statusChangeTime || recordAfter.statusChangeTimeNano != record.statusChangeTimeNano ){
+		return record.hash;
+	}
+
+	const std::string tempFileName = getTemporaryFileName(recordFileName);
+	std::ofstream fout( tempFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+	if( fout.fail() ){
+		std::cerr << "Warning : Failed to open " << tempFileName << ". The hash value of " << fileName << " is not stored." << std::endl;
+		return record.hash;
+	}
+	fout.write( reinterpret_cast<const char*>(&record), sizeof(FileHashRecord) );
+	fout.close();
+	if( fout.fail() || rename( tempFileName.c_str(), recordFileName.c_str() ) != 0 ){
+		std::cerr << "Warning : Failed to write " << recordFileName << ". The hash value of " << fileName << " is not stored." << std::endl;
+		remove( tempFileName.c_str() );
+	}
+	return record.hash;
+
+}
+
+// Calculate hash value of a string
+unsigned long long SelectionCache::calcHashOfString( const std::string& str ){
+
+	unsigned long long hash = offsetBasisOfHash;
+	for( std::string::const_iterator itr = str.begin(); itr != str.end(); ++itr ){
+		hash ^= static_cast<unsigned char>(*itr);
+		hash *= primeOfHash;
+	}
+	return hash;
+
+}
+
+// Load the selected elements of the specified key
+bool SelectionCache::load( const std::string& key, int& meshType, int& numElemTotal, std::set<int>& elementsSelected ) const{
+
+	std::ifstream fin( getFileName(key).c_str(), std::ios::in | std::ios::binary );
+	if( fin.fail() ){
+		return false;
+	}
+
+	Header header;
+	fin.read( reinterpret_cast<char*>(&header), sizeof(Header) );
+	if( fin.fail() || memcmp( header.magic, magicOfSelectionCache, sizeof(magicOfSelectionCache) ) != 0 ||
+		header.version != m_version || header.keyLength != static_cast<int>( key.size() ) || header.encodedSize < 0 ){
+		return false;
+	}
+
+	std::string keyStored( header.keyLength, '\0' );
+	if( header.keyLength > 0 ){
+		fin.read( &keyStored[0], header.keyLength );
+	}
+	if( fin.fail() || keyStored != key ){
+		// Collision of the hash values
+		return false;
+	}
+
+	std::string encoded( static_cast<size_t>( header.encodedSize ), '\0' );
+	if( header.encodedSize > 0 ){
+		fin.read( &encoded[0], header.encodedSize );
+	}
+	if( fin.fail() ){
+		return false;
+	}
+	fin.close();
+
+	if( !decode( encoded, header.numElemTotal, header.numElemSelected, elementsSelected ) ){
+		elementsSelected.clear();
+		return false;
+	}
+	meshType = header.meshType;
+	numElemTotal = header.numElemTotal;
+	return true;
+
+}
+
+// Store the selected elements of the specified key
+void SelectionCache::store( const std::string& key, const int meshType, const int numElemTotal, const std::set<int>& elementsSelected ) const{
+
+	if( !m_isWritable ){
+		return;
+	}
+
+	std::string encoded;
+	encode( elementsSelected, encoded );
+
+	Header header;
+	memset( &header, 0, sizeof(Header) );
+	memcpy( header.magic, magicOfSelectionCache, sizeof(magicOfSelectionCache) );
+	header.version = m_version;
+	header.meshType = meshType;
+	header.numElemTotal = numElemTotal;
+	header.numElemSelected = static_cast<int>( elementsSelected.size() );
+	header.keyLength = static_cast<int>( key.size() );
+	header.encodedSize = static_cast<long long>( encoded.size() );
+
+	const std::string fileName = getFileName(key);
+	const std::string tempFileName = getTemporaryFileName(fileName);
+
+	std::ofstream fout( tempFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+	if( fout.fail() ){
+		std::cerr << "Warning : Failed to open " << tempFileName << ". The entry is not stored." << std::endl;
+		return;
+	}
+	fout.write( reinterpret_cast<const char*>(&header), sizeof(Header) );
+	fout.write( key.data(), key.size() );
+	fout.write( encoded.data(), encoded.size() );
+	fout.close();
+	if( fout.fail() ){
+		std::cerr << "Warning : Failed to write " << tempFileName << ". The entry is not stored." << std::endl;
+		remove( tempFileName.c_str() );
+		return;
+	}
+
+	if( rename( tempFileName.c_str(), fileName.c_str() ) != 0 ){
+		std::cerr << "Warning : Failed to rename " << tempFileName << " to " << fileName << ". The entry is not stored." << std::endl;
+		remove( tempFileName.c_str() );
+		return;
+	}
+
+}
+
+// Get name of the file of the entry of the specified key
+std::string SelectionCache::getFileName( const std::string& key ) const{
+
+	std::ostringstream oss;
+	oss << m_directory << "/selection_" << std::hex << std::setw(16) << std::setfill('0') << calcHashOfString(key) << ".dat";
+	return oss.str();
+
+}
+
+// Get status of a file as a record without the hash value
+bool SelectionCache::getFileStatus( const std::string& fileName, FileHashRecord& record ){
+
+	memset( &record, 0, sizeof(FileHashRecord) );
+	memcpy( record.magic, magicOfFileHashRecord, sizeof(magicOfFileHashRecord) );
+	record.version = m_version;
+#ifdef _LINUX
+	struct stat status;
+	if( stat( fileName.c_str(), &status ) != 0 ){
+		return false;
+	}
+	record.device = static_cast<long long>( status.st_dev );
+	record.inode = static_cast<long long>( status.st_ino );
+	record.size = static_cast<long long>( status.st_size );
+	record.modificationTime = static_cast<long long>( status.st_mtim.tv_sec );
+	record.modificationTimeNano = static_cast<long long>( status.st_mtim.tv_nsec );
+	record.statusChangeTime = static_cast<long long>( status.st_ctim.tv_sec );
+	record.statusChangeTimeNano = static_cast<long long>( status.st_ctim.tv_nsec );
+	return true;
+#else
+	return false;
+#endif
+
+}
+
+// Get name of the file of the record of the hash value
+std::string SelectionCache::getFileNameOfHashRecord( const FileHashRecord& record ) const{
+
+	std::ostringstream oss;
+	oss << m_directory << "/hash_" << std::hex << record.device << "_" << record.inode << ".dat";
+	return oss.str();
+
+}
+
+// Get name of the temporary file which is unique among the processes and the threads
+std::string SelectionCache::getTemporaryFileName( const std::string& fileName ){
+
+	std::ostringstream oss;
+	oss << fileName << ".tmp";
+#ifdef _LINUX
+	oss << getpid() << "_" << __sync_fetch_and_add( &numTemporaryFiles, 1 );
+#endif
+	return oss.str();
+
+}
+
+// Compress bitmap of the selected elements
+void SelectionCache::encode( const std::set<int>& elementsSelected, std::string& encoded ){
+
+	encoded.clear();
+	int prev(-1);
+	for( std::set<int>::const_iterator itr = elementsSelected.begin(); itr != elementsSelected.end(); ++itr ){
+		// Gap from the previous set bit, which is positive, written seven bits per byte
+		unsigned int gap = static_cast<unsigned int>( *itr - prev );
+		prev = *itr;
+		while( gap >= 0x80 ){
+			encoded.push_back( static_cast<char>( ( gap & 0x7F ) | 0x80 ) );
+			gap >>= 7;
+		}
+		encoded.push_back( static_cast<char>(gap) );
+	}
+
+}
+
+// Decompress bitmap of the selected elements
+bool SelectionCache::decode( const std::string& encoded, const int numElemTotal, const int numElemSelected, std::set<int>& elementsSelected ){
+
+	elementsSelected.clear();
+	long long elem(-1);
+	unsigned int gap(0);
+	int shift(0);
+	for( std::string::const_iterator itr = encoded.begin(); itr != encoded.end(); ++itr ){
+		const unsigned int byte = static_cast<unsigned char>(*itr);
+		if( shift > 28 ){
+			return false;
+		}
+		gap |= ( byte & 0x7F ) << shift;
+		if( ( byte & 0x80 ) != 0 ){
+			shift += 7;
+			continue;
+		}
+		elem += gap;
+		if( gap == 0 || elem >= numElemTotal ){
+			return false;
+		}
+		elementsSelected.insert( elementsSelected.end(), static_cast<int>(elem) );
+		gap = 0;
+		shift = 0;
+	}
+
+	return shift == 0 && static_cast<int>( elementsSelected.size() ) == numElemSelected;
+
+}
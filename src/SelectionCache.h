@@ -0,0 +1,146 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#ifndef DBLDEF_SELECTION_CACHE
+#define DBLDEF_SELECTION_CACHE
+
+#include <string>
+#include <set>
+
+// Class of on-disk cache of the selected elements
+// Each entry is keyed by the hash values of the mesh file and the resistivity block file together with
+// the canonical parameters of the selection. The selected elements are stored as a bitmap over all the
+// elements which is compressed by writing the gaps between the set bits as variable-length integers.
+// The key itself is stored in the entry so that a collision of the hash values is detected.
+class SelectionCache{
+
+public:
+
+	// Constructer
+	SelectionCache();
+
+	// Destructer
+	~SelectionCache();
+
+	// Set directory in which the entries are stored
+	// [note] : The directory is created if it does not exist. If it is not writable, the entries are only loaded.
+	void setDirectory( const std::string& directory );
+
+	// Calculate hash value of a file
+	static unsigned long long calcHashOfFile( const std::string& fileName );
+
+	// Get hash value of a file
+	// [note] : The hash value is recorded in the directory together with the identity, the size and the times of
+	//          modification and status change of the file, so that an unchanged file is not read again.
+	unsigned long long getHashOfFile( const std::string& fileName ) const;
+
+	// Calculate hash value of a string
+	static unsigned long long calcHashOfString( const std::string& str );
+
+	// Load the selected elements of the specified key
+	// [note] : False is returned if the entry does not exist or is not consistent with the key
+	bool load( const std::string& key, int& meshType, int& numElemTotal, std::set<int>& elementsSelected ) const;
+
+	// Store the selected elements of the specified key
+	// [note] : The entry is written to a temporary file and renamed so that other processes never read a partial entry.
+	//          Failure in storing is only warned because the cache is not necessary for the results.
+	void store( const std::string& key, const int meshType, const int numElemTotal, const std::set<int>& elementsSelected ) const;
+
+private:
+
+	// Copy constructer
+	SelectionCache(const SelectionCache& rhs);
+
+	// Copy assignment operator
+	SelectionCache& operator=(const SelectionCache& rhs);
+
+	// Header of the entry
+	struct Header{
+		// Magic number identifying the entry
+		char magic[8];
+		// Version of the format
+		int version;
+		// Type of mesh
+		int meshType;
+		// Total number of elements
+		int numElemTotal;
+		// Number of the selected elements
+		int numElemSelected;
+		// Length of the key in bytes
+		int keyLength;
+		// Size of the compressed bitmap in bytes
+		long long encodedSize;
+	};
+
+	// Record of the hash value of a file
+	struct FileHashRecord{
+		// Magic number identifying the record
+		char magic[8];
+		// Version of the format
+		int version;
+		// Device and inode number of the file
+		long long device;
+		long long inode;
+		// Size of the file in bytes
+		long long size;
+		// Times of modification and status change of the file in seconds and nanoseconds
+		long long modificationTime;
+		long long modificationTimeNano;
+		long long statusChangeTime;
+		long long statusChangeTimeNano;
+		// Hash value of the file
+		unsigned long long hash;
+	};
+
+	// Version of the format of the entry
+	static const int m_version = 1;
+
+	// Directory in which the entries are stored
+	std::string m_directory;
+
+	// Flag specifing whether the entries can be stored in the directory
+	bool m_isWritable;
+
+	// Get name of the file of the entry of the specified key
+	std::string getFileName( const std::string& key ) const;
+
+	// Get status of a file as a record without the hash value
+	// [note] : False is returned if the status cannot be obtained
+	static bool getFileStatus( const std::string& fileName, FileHashRecord& record );
+
+	// Get name of the file of the record of the hash value
+	std::string getFileNameOfHashRecord( const FileHashRecord& record ) const;
+
+	// Get name of the temporary file which is unique among the processes and the threads
+	static std::string getTemporaryFileName( const std::string& fileName );
+
+	// Compress bitmap of the selected elements
+	static void encode( const std::set<int>& elementsSelected, std::string& encoded );
+
+	// Decompress bitmap of the selected elements
+	// [note] : False is returned if the data are broken
+	static bool decode( const std::string& encoded, const int numElemTotal, const int numElemSelected, std::set<int>& elementsSelected );
+
+};
+
+#endif
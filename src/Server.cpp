@@ -0,0 +1,316 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#include <iostream>
+#include <sstream>
+#include <set>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#ifdef _LINUX
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/stat.h>
+#endif
+
+#include "Server.h"
+
+// Constructer
+Server::Server( const bool isTetra, const MeshData* const ptrMeshData, const ResistivityBlock* const ptrResistivityBlock,
+	const ElementSelector* const ptrSelector, const int iterNum ):
+	m_isTetra(isTetra),
+	m_ptrMeshData(ptrMeshData),
+	m_ptrResistivityBlock(ptrResistivityBlock),
+	m_ptrSelector(ptrSelector),
+	m_iterNum(iterNum),
+	m_hasRegion(false),
+	m_resistivityBlockMod(ptrResistivityBlock)
+{
+	m_selectionParameters.selectionMode = ElementSelector::CENTER_OF_ELEMENT;
+	m_selectionParameters.numGaussPoints = 2;
+	m_selectionParameters.thresholdVolumeFraction = 0.5;
+	m_selectionParameters.resistivityMin = 0.1;
+	m_selectionParameters.resistivityMax = 1.0e4;
+	m_ptrSelector->calcEligibility( *m_ptrResistivityBlock, m_selectionParameters.resistivityMin, m_selectionParameters.resistivityMax, m_eligibility );
+}
+
+// Destructer
+Server::~Server(){
+}
+
+// Copy constructer
+Server::Server(const Server& rhs):
+	m_resistivityBlockMod(rhs.m_resistivityBlockMod)
+{
+	std::cerr << "Error : Copy constructer of the class Server is not implemented." << std::endl;
+	exit(1);
+}
+
+// Assignment operator
+Server& Server::operator=(const Server& rhs){
+	std::cerr << "Error : Assignment operator of the class Server is not implemented." << std::endl;
+	exit(1);
+}
+
+// Receive and process requests until shutdown is requested
+// Connections are accepted one after another and the modified model is kept between them.
+void Server::run( const std::string& socketPath ){
+
+#ifdef _LINUX
+	sockaddr_un address;
+	memset( &address, 0, sizeof(address) );
+	address.sun_family = AF_UNIX;
+	if( socketPath.size() >= sizeof(address.sun_path) ){
+		std::cerr << "Path of the socket is too long : " << socketPath << std::endl;
+		exit(1);
+	}
+	strcpy( address.sun_path, socketPath.c_str() );
+
+	const int socketListen = socket( AF_UNIX, SOCK_STREAM, 0 );
+	if( socketListen < 0 ){
+		std::cerr << "Failed to create socket : " << strerror(errno) << std::endl;
+		exit(1);
+	}
+	// Only a socket left by a server which is not running is removed
+	struct stat status;
+	if( lstat( socketPath.c_str(), &status ) == 0 ){
+		if( !S_ISSOCK( status.st_mode ) ){
+			std::cerr << "Path of the socket already exists and is not a socket : " << socketPath << std::endl;
+			exit(1);
+		}
+		const int socketTest = socket( AF_UNIX, SOCK_STREAM, 0 );
+		if( socketTest >= 0 && connect( socketTest, reinterpret_cast<sockaddr*>(&address), sizeof(address) ) == 0 ){
+			std::cerr << "Another server is waiting for requests on socket : " << socketPath << std::endl;
+			exit(1);
+		}
+		if( socketTest >= 0 ){
+			close( socketTest );
+		}
+		unlink( socketPath.c_str() );
+	}
+	if( bind( socketListen, reinterpret_cast<sockaddr*>(&address), sizeof(address) ) < 0 ){
+		std::cerr << "Failed to bind socket to " << socketPath << " : " << strerror(errno) << std::endl;
+		exit(1);
+	}
+	// The socket created by this server is identified by its device and inode
+	struct stat statusOfSocket;
+	memset( &statusOfSocket, 0, sizeof(statusOfSocket) );
+	lstat( socketPath.c_str(), &statusOfSocket );
+	if( listen( socketListen, 4 ) < 0 ){
+		std::cerr << "Failed to listen on socket : " << strerror(errno) << std::endl;
+		exit(1);
+	}
+	std::cout << "Waiting for requests on socket : " << socketPath << std::endl;
+
+	bool isShutdown(false);
+	while( !isShutdown ){
+		const int socketConnected = accept( socketListen, NULL, NULL );
+		if( socketConnected < 0 ){
+			if( errno == EINTR ){
+				continue;
+			}
+			std::cerr << "Failed to accept connection : " << strerror(errno) << std::endl;
+			break;
+		}
+
+		std::string received;
+		char buffer[4096];
+		bool isClosed(false);
+		while( !isClosed ){
+			const ssize_t numBytes = recv( socketConnected, buffer, sizeof(buffer), 0 );
+			if( numBytes < 0 && errno == EINTR ){
+				continue;
+			}
+			if( numBytes <= 0 ){
+				break;
+			}
+			received.append( buffer, numBytes );
+			std::string::size_type pos(0);
+			while( !isClosed && ( pos = received.find('\n') ) != std::string::npos ){
+				std::string request = received.substr( 0, pos );
+				received.erase( 0, pos + 1 );
+				if( !request.empty() && request[request.size() - 1] == '\r' ){
+					request.erase( request.size() - 1 );
+				}
+				std::string reply;
+				const int result = processRequest( request, reply );
+				reply += '\n';
+				// Data are sent without SIGPIPE so that a client closed early does not stop the server
+				std::string::size_type numSent(0);
+				while( numSent < reply.size() ){
+					const ssize_t num = send( socketConnected, reply.c_str() + numSent, reply.size() - numSent, MSG_NOSIGNAL );
+					if( num < 0 && errno == EINTR ){
+						continue;
+					}
+					if( num <= 0 ){
+						isClosed = true;
+						break;
+					}
+					numSent += num;
+				}
+				if( result == CLOSE_CONNECTION ){
+					isClosed = true;
+				}else if( result == SHUTDOWN_SERVER ){
+					isClosed = true;
+					isShutdown = true;
+				}
+			}
+		}
+		close( socketConnected );
+	}
+
+	close( socketListen );
+	if( lstat( socketPath.c_str(), &status ) == 0 && S_ISSOCK( status.st_mode ) &&
+		status.st_dev == statusOfSocket.st_dev && status.st_ino == statusOfSocket.st_ino ){
+		unlink( socketPath.c_str() );
+	}
+#else
+	std::cerr << "Server mode is supported only on Linux !!" << std::endl;
+	exit(1);
+#endif
+
+}
+
+// Process a request and make the reply
+int Server::processRequest( const std::string& request, std::string& reply ){
+
+	std::istringstream iss( request );
+	std::string command;
+	iss >> command;
+	std::ostringstream oss;
+
+	if( command.compare("REGION") == 0 ){
+		int type(0);
+		double xLength(0.0);
+		double yLength(0.0);
+		double zLength(0.0);
+		CommonParameters::locationXYZ center = { 0.0, 0.0, 0.0 };
+		double angle(0.0);
+		if( !( iss >> type >> xLength >> yLength >> zLength >> center.X >> center.Y >> center.Z >> angle ) ){
+			reply = "ERROR REGION requires type, three lengths, three coordinates of the center and angle";
+			return CONTINUE;
+		}
+		if( type < Region::ELLIPSOID || type > Region::CYLINDROID ){
+			reply = "ERROR Region type is wrong";
+			return CONTINUE;
+		}
+		if( xLength <= 0.0 || yLength <= 0.0 || zLength <= 0.0 ){
+			reply = "ERROR Lengths of the region must be positive";
+			return CONTINUE;
+		}
+		center.X *= 1000.0;
+		center.Y *= 1000.0;
+		center.Z *= 1000.0;
+		m_region.setParameters( type, center, xLength * 1000.0, yLength * 1000.0, zLength * 1000.0, angle * CommonParameters::deg2rad );
+		m_hasRegion = true;
+		reply = "OK";
+	}else if( command.compare("RANGE") == 0 ){
+		double resistivityMin(0.0);
+		double resistivityMax(0.0);
+		if( !( iss >> resistivityMin >> resistivityMax ) ){
+			reply = "ERROR RANGE requires minimum and maximum resistivity";
+			return CONTINUE;
+		}
+		m_selectionParameters.resistivityMin = resistivityMin;
+		m_selectionParameters.resistivityMax = resistivityMax;
+		m_ptrSelector->calcEligibility( *m_ptrResistivityBlock, resistivityMin, resistivityMax, m_eligibility );
+		oss << "OK " << m_eligibility.positions.size();
+		reply = oss.str();
+	}else if( command.compare("MODE") == 0 ){
+		int mode(-1);
+		iss >> mode;
+		if( mode == ElementSelector::CENTER_OF_ELEMENT ){
+			m_selectionParameters.selectionMode = mode;
+			reply = "OK";
+		}else if( mode == ElementSelector::VOLUME_FRACTION ){
+			int numGaussPoints(0);
+			double threshold(0.0);
+			if( !( iss >> numGaussPoints >> threshold ) || numGaussPoints < 1 || numGaussPoints > 3 ){
+				reply = "ERROR MODE 1 requires number of Gauss points (1, 2 or 3) and threshold";
+				return CONTINUE;
+			}
+			m_selectionParameters.selectionMode = mode;
+			m_selectionParameters.numGaussPoints = numGaussPoints;
+			m_selectionParameters.thresholdVolumeFraction = threshold;
+			reply = "OK";
+		}else{
+			reply = "ERROR Selection mode is wrong";
+		}
+	}else if( command.compare("COUNT") == 0 ){
+		if( !m_hasRegion ){
+			reply = "ERROR Region is not specified";
+			return CONTINUE;
+		}
+		std::set<int> elementsSelected;
+		selectElements( elementsSelected );
+		oss << "OK " << elementsSelected.size();
+		reply = oss.str();
+	}else if( command.compare("MODIFY") == 0 ){
+		double resistivity(0.0);
+		double resistivityMin(0.0);
+		double resistivityMax(0.0);
+		if( !( iss >> resistivity >> resistivityMin >> resistivityMax ) ){
+			reply = "ERROR MODIFY requires resistivity, minimum and maximum resistivity";
+			return CONTINUE;
+		}
+		if( !m_hasRegion ){
+			reply = "ERROR Region is not specified";
+			return CONTINUE;
+		}
+		std::set<int> elementsSelected;
+		selectElements( elementsSelected );
+		m_resistivityBlockMod.changeResistivityOfSelectedElements( elementsSelected, resistivity, resistivityMin, resistivityMax );
+		oss << "OK " << elementsSelected.size();
+		reply = oss.str();
+	}else if( command.compare("WRITE") == 0 ){
+		std::string prefix("");
+		iss >> prefix;
+		m_resistivityBlockMod.outputResisitivityBlock( m_ptrMeshData, m_iterNum, prefix );
+		m_resistivityBlockMod.outputResistivityValuesToBinary( m_isTetra, m_ptrMeshData, m_iterNum, prefix );
+		reply = "OK";
+	}else if( command.compare("RESET") == 0 ){
+		m_resistivityBlockMod.clear();
+		reply = "OK";
+	}else if( command.compare("QUIT") == 0 ){
+		reply = "OK";
+		return CLOSE_CONNECTION;
+	}else if( command.compare("SHUTDOWN") == 0 ){
+		reply = "OK";
+		return SHUTDOWN_SERVER;
+	}else if( command.empty() ){
+		reply = "ERROR Empty request";
+	}else{
+		reply = "ERROR Unknown request : " + command;
+	}
+
+	return CONTINUE;
+
+}
+
+// Select elements with the current parameters
+// [note] : Selection is made against the base model as in the other modes
+void Server::selectElements( std::set<int>& elementsSelected ) const{
+	m_ptrSelector->selectElements( *m_ptrResistivityBlock, m_region, m_selectionParameters, m_eligibility, elementsSelected );
+}
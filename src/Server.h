@@ -0,0 +1,113 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#ifndef DBLDEF_SERVER
+#define DBLDEF_SERVER
+
+#include <string>
+#include "MeshData.h"
+#include "ResistivityBlock.h"
+#include "ResistivityBlockOverlay.h"
+#include "Region.h"
+#include "ElementSelector.h"
+
+// Class of server keeping the mesh and the resistivity block model in memory
+// Requests are received line by line over a Unix domain socket and each request is answered with one line
+// beginning with "OK" or "ERROR". The requests are as follows. Lengths and coordinates are in km and angles in degrees.
+//   REGION <type> <xLength> <yLength> <zLength> <xCenter> <yCenter> <zCenter> <angle> : Set the region
+//   RANGE <min> <max>                 : Set the resistivity range of the elements to be selected
+//   MODE 0                            : Select elements by their centers
+//   MODE 1 <numGauss> <threshold>     : Select elements by volume fraction
+//   COUNT                             : Answer number of the elements selected
+//   MODIFY <resistivity> <min> <max>  : Change resistivity of the elements selected
+//   WRITE [<prefix>]                  : Output the modified model
+//   RESET                             : Discard all the changes
+//   QUIT                              : Close the connection
+//   SHUTDOWN                          : Close the connection and stop the server
+class Server{
+
+public:
+
+	// Constructer
+	Server( const bool isTetra, const MeshData* const ptrMeshData, const ResistivityBlock* const ptrResistivityBlock,
+		const ElementSelector* const ptrSelector, const int iterNum );
+
+	// Destructer
+	~Server();
+
+	// Receive and process requests until shutdown is requested
+	void run( const std::string& socketPath );
+
+private:
+
+	enum RequestResult{
+		CONTINUE = 0,
+		CLOSE_CONNECTION,
+		SHUTDOWN_SERVER,
+	};
+
+	// Copy constructer
+	Server(const Server& rhs);
+
+	// Copy assignment operator
+	Server& operator=(const Server& rhs);
+
+	// Flag specifing whether the mesh consists of tetrahedral elements
+	bool m_isTetra;
+
+	// Pointer to the mesh data
+	const MeshData* m_ptrMeshData;
+
+	// Pointer to the base resistivity block model
+	const ResistivityBlock* m_ptrResistivityBlock;
+
+	// Pointer to the element selector
+	const ElementSelector* m_ptrSelector;
+
+	// Iteration number
+	int m_iterNum;
+
+	// Flag specifing whether the region has been specified
+	bool m_hasRegion;
+
+	// Region where resistivity is changed
+	Region m_region;
+
+	// Parameters of the selection
+	ElementSelector::SelectionParameters m_selectionParameters;
+
+	// Eligibility for the current resistivity range
+	ElementSelector::Eligibility m_eligibility;
+
+	// Modified resistivity block model
+	ResistivityBlockOverlay m_resistivityBlockMod;
+
+	// Process a request and make the reply
+	int processRequest( const std::string& request, std::string& reply );
+
+	// Select elements with the current parameters
+	void selectElements( std::set<int>& elementsSelected ) const;
+
+};
+
+#endif
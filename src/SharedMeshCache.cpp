@@ -0,0 +1,455 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#include <iostream>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <assert.h>
+
+#ifdef _LINUX
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "SharedMeshCache.h"
+
+namespace{
+const char magicOfSharedMeshCache[8] = { 'F', 'E', 'M', 'T', 'I', 'C', 'M', 'S' };
+}
+
+// Constructer
+SharedMeshCache::SharedMeshCache():
+	m_address(NULL),
+	m_size(0),
+	m_hasTimedOut(false)
+{
+}
+
+// Destructer
+SharedMeshCache::~SharedMeshCache(){
+	unmap();
+}
+
+// Copy constructer
+SharedMeshCache::SharedMeshCache(const SharedMeshCache& rhs){
+	std::cerr << "Error : Copy constructer of the class SharedMeshCache is not implemented." << std::endl;
+	exit(1);
+}
+
+// Assignment operator
+SharedMeshCache& SharedMeshCache::operator=(const SharedMeshCache& rhs){
+	std::cerr << "Error : Assignment operator of the class SharedMeshCache is not implemented." << std::endl;
+	exit(1);
+}
+
+// Attach to the segment of the specified name
+bool SharedMeshCache::attach( const std::string& name, const std::string& meshFileName ){
+	return attachSegment( name, meshFileName, m_maxWaitingTime ) == SEGMENT_ATTACHED;
+}
+
+// Publish the mesh data to the segment of the specified name and attach to it
+bool SharedMeshCache::publish( const std::string& name, const std::string& meshFileName, const MeshData* const ptrMeshData ){
+
+#ifdef _LINUX
+	const int numElemTotal = ptrMeshData->getNumElemTotal();
+	const int numNodeTotal = ptrMeshData->getNumNodeTotal();
+	const int numNodeOneElement = ptrMeshData->getNumNodeOneElement();
+
+	Header header;
+	memset( &header, 0, sizeof(header) );
+	memcpy( header.magic, magicOfSharedMeshCache, sizeof(magicOfSharedMeshCache) );
+	header.version = m_version;
+	header.meshType = ptrMeshData->getMeshType();
+	header.numElemTotal = numElemTotal;
+	header.numNodeTotal = numNodeTotal;
+	header.numNodeOneElement = numNodeOneElement;
+	header.isComplete = 0;
+	if( !getMeshFileStatus( meshFileName, header.meshFileSize, header.meshFileModificationTime ) ){
+		std::cerr << "Failed to get status of " << meshFileName << std::endl;
+		exit(1);
+	}
+
+	const long long sizes[NUM_ARRAYS] = {
+		static_cast<long long>( sizeof(double) ) * numNodeTotal,
+		static_cast<long long>( sizeof(double) ) * numNodeTotal,
+		static_cast<long long>( sizeof(double) ) * numNodeTotal,
+		static_cast<long long>( sizeof(int) ) * numElemTotal * numNodeOneElement,
+		static_cast<long long>( sizeof(int) ) * numElemTotal,
+		static_cast<long long>( sizeof(double) ) * numElemTotal,
+		static_cast<long long>( sizeof(double) ) * numElemTotal,
+		static_cast<long long>( sizeof(double) ) * numElemTotal,
+	};
+	long long offset = ( static_cast<long long>( sizeof(Header) ) + m_alignment - 1 ) / m_alignment * m_alignment;
+	for( int iArray = 0; iArray < NUM_ARRAYS; ++iArray ){
+		header.offsets[iArray] = offset;
+		offset += ( sizes[iArray] + m_alignment - 1 ) / m_alignment * m_alignment;
+	}
+	header.totalSize = offset;
+
+	// The segment is created exclusively, so that the segment being published by another process is not removed.
+	// It is locked until it is completed, so that the other processes can find that the publisher has gone.
+	int fd(-1);
+	for( int iTrial = 0; ; ++iTrial ){
+		fd = shm_open( name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644 );
+		if( fd >= 0 ){
+			if( !lockSegment(fd) ){
+				std::cout << "Mesh data are not shared because shared memory " << name << " cannot be locked : " << strerror(errno) << std::endl;
+				close(fd);
+				return false;
+			}
+			break;
+		}
+		if( errno != EEXIST ){
+			std::cerr << "Failed to create shared memory " << name << " : " << strerror(errno) << std::endl;
+			exit(1);
+		}
+		// The segment is not waited for again if it has not been completed while attaching
+		switch( attachSegment( name, meshFileName, m_hasTimedOut ? 0 : m_maxWaitingTime ) ){
+			case SEGMENT_ATTACHED:
+				// Another process has published the mesh data
+				return true;
+			case SEGMENT_INCOMPLETE:
+				std::cout << "Mesh data are not shared because shared memory " << name << " is not completed by another process" << std::endl;
+				return false;
+			case SEGMENT_INVALID:
+				// Only a segment which is stale, broken or left incomplete by a terminated publisher is replaced
+				if( iTrial >= m_maxNumTrialsOfPublishing ){
+					std::cout << "Mesh data are not shared because shared memory " << name << " cannot be replaced" << std::endl;
+					return false;
+				}
+				removeInvalidSegment(name);
+				break;
+			default:
+				// The segment has been removed by another process
+				break;
+		}
+	}
+	if( ftruncate( fd, header.totalSize ) != 0 ){
+		std::cerr << "Failed to allocate shared memory " << name << " : " << strerror(errno) << std::endl;
+		close(fd);
+		shm_unlink( name.c_str() );
+		exit(1);
+	}
+	void* const address = mmap( NULL, header.totalSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+	if( address == MAP_FAILED ){
+		std::cerr << "Failed to map shared memory " << name << " : " << strerror(errno) << std::endl;
+		shm_unlink( name.c_str() );
+		exit(1);
+	}
+	char* const top = static_cast<char*>(address);
+	memcpy( top, &header, sizeof(header) );
+
+	const double* xCoordinatesOfNodes = NULL;
+	const double* yCoordinatesOfNodes = NULL;
+	const double* zCoordinatesOfNodes = NULL;
+	const int* nodesOfElements = NULL;
+	const int* elementOrder = NULL;
+	ptrMeshData->getArrays( xCoordinatesOfNodes, yCoordinatesOfNodes, zCoordinatesOfNodes, nodesOfElements, elementOrder );
+	if( elementOrder == NULL ){
+		std::cerr << "Error : Elements must be sorted before publishing mesh data." << std::endl;
+		exit(1);
+	}
+	memcpy( top + header.offsets[X_COORDINATES_OF_NODES], xCoordinatesOfNodes, sizes[X_COORDINATES_OF_NODES] );
+	memcpy( top + header.offsets[Y_COORDINATES_OF_NODES], yCoordinatesOfNodes, sizes[Y_COORDINATES_OF_NODES] );
+	memcpy( top + header.offsets[Z_COORDINATES_OF_NODES], zCoordinatesOfNodes, sizes[Z_COORDINATES_OF_NODES] );
+	memcpy( top + header.offsets[NODES_OF_ELEMENTS], nodesOfElements, sizes[NODES_OF_ELEMENTS] );
+	memcpy( top + header.offsets[ELEMENT_ORDER], elementOrder, sizes[ELEMENT_ORDER] );
+
+	double* const xCenter = reinterpret_cast<double*>( top + header.offsets[X_CENTERS] );
+	double* const yCenter = reinterpret_cast<double*>( top + header.offsets[Y_CENTERS] );
+	double* const zCenter = reinterpret_cast<double*>( top + header.offsets[Z_CENTERS] );
+#pragma omp parallel for
+	for( int i = 0; i < numElemTotal; ++i ){
+		const CommonParameters::locationXYZ center = ptrMeshData->getElementCenter( elementOrder[i] );
+		xCenter[i] = center.X;
+		yCenter[i] = center.Y;
+		zCenter[i] = center.Z;
+	}
+
+	// The flag is set after all the data become visible to the other processes
+	__sync_synchronize();
+	reinterpret_cast<Header*>(top)->isComplete = 1;
+	munmap( address, header.totalSize );
+	// The lock is released by closing the descriptor
+	close(fd);
+	std::cout << "Mesh data are published to shared memory : " << name << std::endl;
+
+	if( !attach( name, meshFileName ) ){
+		std::cerr << "Failed to attach shared memory " << name << " just published" << std::endl;
+		exit(1);
+	}
+	return true;
+#else
+	std::cerr << "Shared memory is supported only on Linux !!" << std::endl;
+	exit(1);
+#endif
+
+}
+
+// Get type of mesh
+int SharedMeshCache::getMeshType() const{
+	return getHeader()->meshType;
+}
+
+// Let the mesh data refer to the arrays in the segment
+void SharedMeshCache::attachMeshData( MeshData* const ptrMeshData ) const{
+
+	const Header* const header = getHeader();
+	if( ptrMeshData->getMeshType() != header->meshType || ptrMeshData->getNumNodeOneElement() != header->numNodeOneElement ){
+		std::cerr << "Error : Type of mesh is different from that of the shared memory." << std::endl;
+		exit(1);
+	}
+	ptrMeshData->attachArrays( header->numElemTotal, header->numNodeTotal,
+		static_cast<const double*>( getArray(X_COORDINATES_OF_NODES) ),
+		static_cast<const double*>( getArray(Y_COORDINATES_OF_NODES) ),
+		static_cast<const double*>( getArray(Z_COORDINATES_OF_NODES) ),
+		static_cast<const int*>( getArray(NODES_OF_ELEMENTS) ),
+		static_cast<const int*>( getArray(ELEMENT_ORDER) ) );
+
+}
+
+// Get arrays of coordinates of the element centers in the processing order
+void SharedMeshCache::getCenters( const double*& xCenter, const double*& yCenter, const double*& zCenter ) const{
+	xCenter = static_cast<const double*>( getArray(X_CENTERS) );
+	yCenter = static_cast<const double*>( getArray(Y_CENTERS) );
+	zCenter = static_cast<const double*>( getArray(Z_CENTERS) );
+}
+
+// Get header of the segment
+const SharedMeshCache::Header* SharedMeshCache::getHeader() const{
+	assert( m_address != NULL );
+	return static_cast<const Header*>(m_address);
+}
+
+// Get address of an array in the segment
+const void* SharedMeshCache::getArray( const int iArray ) const{
+	assert( iArray >= 0 );
+	assert( iArray < NUM_ARRAYS );
+	return static_cast<const char*>(m_address) + getHeader()->offsets[iArray];
+}
+
+// Attach to the segment of the specified name and return the state of the segment
+// [note] : The segment being written by another process is waited for until it is completed
+int SharedMeshCache::attachSegment( const std::string& name, const std::string& meshFileName, const int maxWaitingTime ){
+
+	const int state = mapCompletedSegment( name, maxWaitingTime );
+	if( state == SEGMENT_INCOMPLETE ){
+		std::cout << "Shared memory " << name << " has not been completed" << std::endl;
+		m_hasTimedOut = true;
+		return state;
+	}
+	if( state != SEGMENT_ATTACHED ){
+		return state;
+	}
+
+	const Header* const header = getHeader();
+	if( memcmp( header->magic, magicOfSharedMeshCache, sizeof(magicOfSharedMeshCache) ) != 0 || header->version != m_version ){
+		std::cout << "Shared memory " << name << " is not a mesh cache of this version" << std::endl;
+		unmap();
+		return SEGMENT_INVALID;
+	}
+
+	long long meshFileSize(0);
+	long long meshFileModificationTime(0);
+	if( !getMeshFileStatus( meshFileName, meshFileSize, meshFileModificationTime ) ||
+		header->meshFileSize != meshFileSize || header->meshFileModificationTime != meshFileModificationTime ){
+		std::cout << "Shared memory " << name << " was made from another mesh file" << std::endl;
+		unmap();
+		return SEGMENT_INVALID;
+	}
+
+	if( header->totalSize != m_size ){
+		std::cout << "Size of shared memory " << name << " is wrong" << std::endl;
+		unmap();
+		return SEGMENT_INVALID;
+	}
+
+	std::cout << "Mesh data are attached from shared memory : " << name << std::endl;
+	return SEGMENT_ATTACHED;
+
+}
+
+// Map the segment of the specified name read-only after it is completed
+// [note] : A segment whose header has not been written yet or whose flag of completion is not set is regarded as being written.
+//          Such a segment which is not locked by the publisher in two successive checks is regarded as invalid
+//          because the publisher has terminated before completing it.
+//          A segment having another magic number is mapped as it is, so that it is found to be invalid.
+int SharedMeshCache::mapCompletedSegment( const std::string& name, const int maxWaitingTime ){
+
+	unmap();
+#ifdef _LINUX
+	const char zeros[sizeof(magicOfSharedMeshCache)] = { 0 };
+	int numChecksWithoutPublisher(0);
+	for( int i = 0; i <= maxWaitingTime * 10; ++i ){
+		if( i > 0 ){
+			usleep(100000);
+		}
+		const int fd = shm_open( name.c_str(), O_RDONLY, 0 );
+		if( fd < 0 ){
+			return SEGMENT_NOT_FOUND;
+		}
+		struct stat status;
+		if( fstat( fd, &status ) != 0 ){
+			close(fd);
+			return SEGMENT_NOT_FOUND;
+		}
+		bool isCompleted(false);
+		void* address(NULL);
+		if( status.st_size >= static_cast<off_t>( sizeof(Header) ) ){
+			address = mmap( NULL, status.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+			if( address == MAP_FAILED ){
+				close(fd);
+				return SEGMENT_NOT_FOUND;
+			}
+			const Header* const header = static_cast<const Header*>(address);
+			isCompleted = memcmp( header->magic, zeros, sizeof(zeros) ) != 0 &&
+				( memcmp( header->magic, magicOfSharedMeshCache, sizeof(magicOfSharedMeshCache) ) != 0 || header->isComplete != 0 );
+		}
+		if( isCompleted ){
+			close(fd);
+			__sync_synchronize();
+			m_address = address;
+			m_size = status.st_size;
+			return SEGMENT_ATTACHED;
+		}
+		if( address != NULL ){
+			munmap( address, status.st_size );
+		}
+		if( isLockedBySomeone(fd) ){
+			numChecksWithoutPublisher = 0;
+		}else{
+			++numChecksWithoutPublisher;
+		}
+		close(fd);
+		if( numChecksWithoutPublisher >= 2 ){
+			std::cout << "Shared memory " << name << " was left incomplete by a terminated process" << std::endl;
+			return SEGMENT_INVALID;
+		}
+	}
+	return SEGMENT_INCOMPLETE;
+#else
+	return SEGMENT_NOT_FOUND;
+#endif
+
+}
+
+// Remove the invalid segment of the specified name
+// [note] : The segment is locked while it is removed, and it is removed only if the name still refers to it,
+//          so that the segment newly published by another process is not removed.
+void SharedMeshCache::removeInvalidSegment( const std::string& name ){
+
+#ifdef _LINUX
+	const int fd = shm_open( name.c_str(), O_RDWR, 0 );
+	if( fd < 0 ){
+		return;
+	}
+	struct stat statusLocked;
+	if( !lockSegment(fd) || fstat( fd, &statusLocked ) != 0 ){
+		// The segment is being replaced by another process
+		close(fd);
+		return;
+	}
+	const int fdCurrent = shm_open( name.c_str(), O_RDONLY, 0 );
+	if( fdCurrent >= 0 ){
+		struct stat statusCurrent;
+		if( fstat( fdCurrent, &statusCurrent ) == 0 &&
+			statusCurrent.st_dev == statusLocked.st_dev && statusCurrent.st_ino == statusLocked.st_ino ){
+			shm_unlink( name.c_str() );
+		}
+		close(fdCurrent);
+	}
+	close(fd);
+#endif
+
+}
+
+// Lock the whole segment for writing without waiting
+bool SharedMeshCache::lockSegment( const int fd ){
+
+#ifdef _LINUX
+	struct flock lock;
+	memset( &lock, 0, sizeof(lock) );
+	lock.l_type = F_WRLCK;
+	lock.l_whence = SEEK_SET;
+	lock.l_start = 0;
+	lock.l_len = 0;
+	return fcntl( fd, F_SETLK, &lock ) == 0;
+#else
+	return false;
+#endif
+
+}
+
+// Check whether the segment is locked by a process
+bool SharedMeshCache::isLockedBySomeone( const int fd ){
+
+#ifdef _LINUX
+	struct flock lock;
+	memset( &lock, 0, sizeof(lock) );
+	lock.l_type = F_WRLCK;
+	lock.l_whence = SEEK_SET;
+	lock.l_start = 0;
+	lock.l_len = 0;
+	if( fcntl( fd, F_GETLK, &lock ) != 0 ){
+		// The segment is regarded as locked because the lock cannot be examined
+		return true;
+	}
+	return lock.l_type != F_UNLCK;
+#else
+	return true;
+#endif
+
+}
+
+// Unmap the segment
+void SharedMeshCache::unmap(){
+
+#ifdef _LINUX
+	if( m_address != NULL ){
+		munmap( m_address, m_size );
+	}
+#endif
+	m_address = NULL;
+	m_size = 0;
+
+}
+
+// Get size and modification time of the mesh file
+bool SharedMeshCache::getMeshFileStatus( const std::string& meshFileName, long long& size, long long& modificationTime ){
+
+#ifdef _LINUX
+	struct stat status;
+	if( stat( meshFileName.c_str(), &status ) != 0 ){
+		return false;
+	}
+	size = static_cast<long long>( status.st_size );
+	modificationTime = static_cast<long long>( status.st_mtime );
+	return true;
+#else
+	return false;
+#endif
+
+}
@@ -0,0 +1,171 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#ifndef DBLDEF_SHARED_MESH_CACHE
+#define DBLDEF_SHARED_MESH_CACHE
+
+#include <string>
+#include "MeshData.h"
+
+// Class of mesh data shared among processes through a named POSIX shared-memory segment
+// The segment contains a header, the arrays of nodes and elements after sorting along the space-filling curve,
+// and the coordinates of the element centers in the processing order. It is published by the first process
+// and attached read-only by the others. The publisher holds a lock of the segment until it is completed.
+// The segment remains until it is removed (e.g. rm /dev/shm/<name>).
+class SharedMeshCache{
+
+public:
+
+	// Constructer
+	SharedMeshCache();
+
+	// Destructer
+	~SharedMeshCache();
+
+	// Attach to the segment of the specified name
+	// [note] : False is returned if the segment does not exist or is not consistent with the mesh file.
+	//          The segment being published by another process is waited for until it is completed.
+	//          The segment left incomplete by a terminated publisher is regarded as not being consistent.
+	bool attach( const std::string& name, const std::string& meshFileName );
+
+	// Publish the mesh data to the segment of the specified name and attach to it
+	// [note] : Elements must have been sorted along the space-filling curve.
+	//          If the segment is being published by another process, it is attached after completion instead.
+	//          A completed segment which is not consistent with the mesh file is replaced.
+	//          A segment left incomplete by a terminated publisher is also replaced.
+	//          The segment which has not been completed in attaching is not waited for again.
+	//          False is returned if the mesh data are not shared.
+	bool publish( const std::string& name, const std::string& meshFileName, const MeshData* const ptrMeshData );
+
+	// Get type of mesh
+	int getMeshType() const;
+
+	// Let the mesh data refer to the arrays in the segment
+	void attachMeshData( MeshData* const ptrMeshData ) const;
+
+	// Get arrays of coordinates of the element centers in the processing order
+	void getCenters( const double*& xCenter, const double*& yCenter, const double*& zCenter ) const;
+
+private:
+
+	// Copy constructer
+	SharedMeshCache(const SharedMeshCache& rhs);
+
+	// Copy assignment operator
+	SharedMeshCache& operator=(const SharedMeshCache& rhs);
+
+	enum Arrays{
+		X_COORDINATES_OF_NODES = 0,
+		Y_COORDINATES_OF_NODES,
+		Z_COORDINATES_OF_NODES,
+		NODES_OF_ELEMENTS,
+		ELEMENT_ORDER,
+		X_CENTERS,
+		Y_CENTERS,
+		Z_CENTERS,
+		NUM_ARRAYS,
+	};
+
+	enum SegmentStates{
+		SEGMENT_ATTACHED = 0,
+		SEGMENT_NOT_FOUND,
+		SEGMENT_INCOMPLETE,
+		SEGMENT_INVALID,
+	};
+
+	// Header of the segment
+	struct Header{
+		// Magic number identifying the segment
+		char magic[8];
+		// Version of the layout
+		int version;
+		// Type of mesh
+		int meshType;
+		// Total number of elements
+		int numElemTotal;
+		// Total number of nodes
+		int numNodeTotal;
+		// Number of nodes belonging to one element
+		int numNodeOneElement;
+		// Nonzero after all the arrays have been written
+		volatile int isComplete;
+		// Size and modification time of the mesh file from which the data were made
+		long long meshFileSize;
+		long long meshFileModificationTime;
+		// Offsets of the arrays from the top of the segment in bytes
+		long long offsets[NUM_ARRAYS];
+		// Total size of the segment in bytes
+		long long totalSize;
+	};
+
+	// Version of the layout of the segment
+	static const int m_version = 1;
+
+	// Alignment of the arrays in bytes
+	static const int m_alignment = 64;
+
+	// Maximum time waiting for the segment to be completed by another process in seconds
+	static const int m_maxWaitingTime = 60;
+
+	// Maximum number of the trials replacing a stale segment in publishing
+	static const int m_maxNumTrialsOfPublishing = 3;
+
+	// Top address of the mapped segment
+	void* m_address;
+
+	// Size of the mapped segment
+	long long m_size;
+
+	// Flag specifing whether waiting for the completion of the segment has timed out
+	bool m_hasTimedOut;
+
+	// Get header of the segment
+	const Header* getHeader() const;
+
+	// Get address of an array in the segment
+	const void* getArray( const int iArray ) const;
+
+	// Attach to the segment of the specified name and return the state of the segment
+	int attachSegment( const std::string& name, const std::string& meshFileName, const int maxWaitingTime );
+
+	// Map the segment of the specified name read-only after it is completed
+	int mapCompletedSegment( const std::string& name, const int maxWaitingTime );
+
+	// Remove the invalid segment of the specified name
+	static void removeInvalidSegment( const std::string& name );
+
+	// Lock the whole segment for writing without waiting
+	static bool lockSegment( const int fd );
+
+	// Check whether the segment is locked by a process
+	static bool isLockedBySomeone( const int fd );
+
+	// Unmap the segment
+	void unmap();
+
+	// Get size and modification time of the mesh file
+	static bool getMeshFileStatus( const std::string& meshFileName, long long& size, long long& modificationTime );
+
+};
+
+#endif
@@ -0,0 +1,528 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#include <iostream>
+#include <algorithm>
+#include <stdlib.h>
+#include <limits.h>
+#include <math.h>
+
+#include "SyntheticMeshGenerator.h"
+#include "MeshData.h"
+#include "ResistivityBlock.h"
+
+namespace{
+// Permutations of the axes along which the vertices of the tetrahedra of a cell are visited
+const int axesOfTetra[6][3] = { {0,1,2}, {0,2,1}, {1,0,2}, {1,2,0}, {2,0,1}, {2,1,0} };
+// Index of the permutation of axes
+inline int getTetraIndex( const int a, const int b, const int c ){
+	return 2 * a + ( b > c ? 1 : 0 );
+}
+// Flag specifing whether the permutation is odd
+inline bool isOddPermutation( const int iTetra ){
+	return iTetra == 1 || iTetra == 2 || iTetra == 5;
+}
+}
+
+// Constructer
+SyntheticMeshGenerator::SyntheticMeshGenerator( const Parameters& params ):
+	m_params(params),
+	m_numBlocksX(0),
+	m_numBlocksY(0),
+	m_numBlocksZ(0)
+{
+	const int numEarthLayers = m_params.numCellsZ - m_params.numAirLayers;
+	if( m_params.numCellsX < 1 || m_params.numCellsY < 1 || m_params.numAirLayers < 1 || numEarthLayers < 1 ){
+		std::cerr << "Error : There must be at least one cell along each axis and at least one air layer and one earth layer !!" << std::endl;
+		exit(1);
+	}
+	if( m_params.meshType != MeshData::DHEXA ){
+		m_params.numRefinedLayers = 0;
+	}
+	if( m_params.numRefinedLayers < 0 || m_params.numRefinedLayers > numEarthLayers ){
+		std::cerr << "Error : Number of the refined layers must be between 0 and the number of the earth layers !!" << std::endl;
+		exit(1);
+	}
+	if( m_params.numCellsOfBlock < 1 ){
+		std::cerr << "Error : Number of the cells of a resistivity block must be positive !!" << std::endl;
+		exit(1);
+	}
+
+	const int numLayers = m_params.numCellsZ;
+	const int numElemOfCell = m_params.meshType == MeshData::TETRA ? 6 : 1;
+	m_numElemXOfLayers.resize(numLayers);
+	m_numElemYOfLayers.resize(numLayers);
+	m_elemOffsetOfLayers.assign(numLayers + 1, 0);
+	for( int iLayer = 0; iLayer < numLayers; ++iLayer ){
+		const int ratio = isRefinedLayer(iLayer) ? 2 : 1;
+		m_numElemXOfLayers[iLayer] = m_params.numCellsX * ratio;
+		m_numElemYOfLayers[iLayer] = m_params.numCellsY * ratio;
+		m_elemOffsetOfLayers[iLayer + 1] = m_elemOffsetOfLayers[iLayer] +
+			static_cast<long long>( m_numElemXOfLayers[iLayer] ) * m_numElemYOfLayers[iLayer] * numElemOfCell;
+	}
+
+	// Node planes bounding the refined layers have the refined nodes
+	m_numNodeXOfPlanes.resize(numLayers + 1);
+	m_numNodeYOfPlanes.resize(numLayers + 1);
+	m_nodeOffsetOfPlanes.assign(numLayers + 2, 0);
+	for( int iPlane = 0; iPlane <= numLayers; ++iPlane ){
+		const bool isRefined = ( iPlane < numLayers && isRefinedLayer(iPlane) ) || ( iPlane > 0 && isRefinedLayer(iPlane - 1) );
+		const int ratio = isRefined ? 2 : 1;
+		m_numNodeXOfPlanes[iPlane] = m_params.numCellsX * ratio + 1;
+		m_numNodeYOfPlanes[iPlane] = m_params.numCellsY * ratio + 1;
+		m_nodeOffsetOfPlanes[iPlane + 1] = m_nodeOffsetOfPlanes[iPlane] +
+			static_cast<long long>( m_numNodeXOfPlanes[iPlane] ) * m_numNodeYOfPlanes[iPlane];
+	}
+
+	if( getNumElemTotal() > INT_MAX || getNumNodeTotal() > INT_MAX ){
+		std::cerr << "Error : Numbers of elements and nodes must be less than " << INT_MAX << " !!" << std::endl;
+		exit(1);
+	}
+	const int numNodeOneElement = m_params.meshType == MeshData::TETRA ? 4 : 8;
+	if( getNumElemTotal() * numNodeOneElement > INT_MAX ){
+		std::cerr << "Warning : The array of the nodes of the elements exceeds the range of the 32-bit indexes used in reading the mesh." << std::endl;
+	}
+
+	m_numBlocksX = ( m_params.numCellsX + m_params.numCellsOfBlock - 1 ) / m_params.numCellsOfBlock;
+	m_numBlocksY = ( m_params.numCellsY + m_params.numCellsOfBlock - 1 ) / m_params.numCellsOfBlock;
+	m_numBlocksZ = ( numEarthLayers + m_params.numCellsOfBlock - 1 ) / m_params.numCellsOfBlock;
+	if( 1 + static_cast<long long>( m_numBlocksX ) * m_numBlocksY * m_numBlocksZ > INT_MAX ){
+		std::cerr << "Error : Number of resistivity blocks must be less than " << INT_MAX << " !!" << std::endl;
+		exit(1);
+	}
+
+}
+
+// Destructer
+SyntheticMeshGenerator::~SyntheticMeshGenerator(){
+}
+
+// Copy constructer
+SyntheticMeshGenerator::SyntheticMeshGenerator(const SyntheticMeshGenerator& rhs){
+	std::cerr << "Error : Copy constructer of the class SyntheticMeshGenerator is not implemented." << std::endl;
+	exit(1);
+}
+
+// Assignment operator
+SyntheticMeshGenerator& SyntheticMeshGenerator::operator=(const SyntheticMeshGenerator& rhs){
+	std::cerr << "Error : Assignment operator of the class SyntheticMeshGenerator is not implemented." << std::endl;
+	exit(1);
+}
+
+// Calculate numbers of the cells whose number of elements is close to the specified one
+void SyntheticMeshGenerator::calcNumCellsFromNumElements( const int meshType, const long long numElemTarget, Parameters& params ){
+
+	for( int n = 2; ; ++n ){
+		const int numSpecialLayers = std::max( 1, n / 8 );
+		params.numCellsX = n;
+		params.numCellsY = n;
+		params.numCellsZ = n;
+		params.numAirLayers = numSpecialLayers;
+		params.numRefinedLayers = meshType == MeshData::DHEXA ? numSpecialLayers : 0;
+		const long long numCellsOfLayer = static_cast<long long>(n) * n;
+		long long numElem(0);
+		if( meshType == MeshData::TETRA ){
+			numElem = 6 * numCellsOfLayer * n;
+		}else{
+			numElem = numCellsOfLayer * ( n - params.numRefinedLayers ) + 4 * numCellsOfLayer * params.numRefinedLayers;
+		}
+		if( numElem >= numElemTarget ){
+			break;
+		}
+	}
+
+}
+
+// Get total number of elements
+long long SyntheticMeshGenerator::getNumElemTotal() const{
+	return m_elemOffsetOfLayers.back();
+}
+
+// Get total number of nodes
+long long SyntheticMeshGenerator::getNumNodeTotal() const{
+	return m_nodeOffsetOfPlanes.back();
+}
+
+// Get total number of resistivity blocks
+int SyntheticMeshGenerator::getNumResistivityBlockTotal() const{
+	return 1 + m_numBlocksX * m_numBlocksY * m_numBlocksZ;
+}
+
+// Write mesh data to file
+void SyntheticMeshGenerator::writeMeshData( const std::string& fileName ) const{
+
+	FILE *fp;
+	if( (fp = fopen( fileName.c_str(), "w")) == NULL ) {
+		std::cerr  << "File open error !! : " << fileName << std::endl;
+		exit(1);
+	}
+
+	fprintf(fp, "%s\n", m_params.meshType == MeshData::TETRA ? "TETRA" : "DHEXA" );
+	fprintf(fp, "%lld\n", getNumNodeTotal() );
+	writeLines( fp, NODE, getNumNodeTotal() );
+	fprintf(fp, "%lld\n", getNumElemTotal() );
+	writeLines( fp, ELEMENT, getNumElemTotal() );
+	if( m_params.meshType == MeshData::TETRA ){
+		writeBoundaryFacesOfTetra(fp);
+	}else{
+		writeBoundaryFacesOfHexa(fp);
+	}
+
+	fclose(fp);
+
+}
+
+// Write resistivity block model to file
+void SyntheticMeshGenerator::writeResistivityBlock( const std::string& fileName ) const{
+
+	FILE *fp;
+	if( (fp = fopen( fileName.c_str(), "w")) == NULL ) {
+		std::cerr  << "File open error !! : " << fileName << std::endl;
+		exit(1);
+	}
+
+	fprintf(fp, "%10lld%10d\n", getNumElemTotal(), getNumResistivityBlockTotal() );
+	writeLines( fp, ELEMENT_TO_BLOCK, getNumElemTotal() );
+	writeLines( fp, BLOCK, getNumResistivityBlockTotal() );
+
+	fclose(fp);
+
+}
+
+// Check whether a layer is refined
+bool SyntheticMeshGenerator::isRefinedLayer( const int iLayer ) const{
+	return iLayer >= m_params.numAirLayers && iLayer < m_params.numAirLayers + m_params.numRefinedLayers;
+}
+
+// Write lines of the specified type in parallel
+void SyntheticMeshGenerator::writeLines( FILE* fp, const int lineType, const long long numLines ) const{
+
+	const long long numChunks = ( numLines + m_numLinesOfChunk - 1 ) / m_numLinesOfChunk;
+
+#pragma omp parallel
+	{
+		char* buffer = new char[ m_numLinesOfChunk * m_maxLineLength ];
+#pragma omp for ordered schedule(static, 1)
+		for( long long iChunk = 0; iChunk < numChunks; ++iChunk ){
+			const long long iBegin = iChunk * m_numLinesOfChunk;
+			const long long iEnd = std::min( iBegin + m_numLinesOfChunk, numLines );
+			size_t length(0);
+			for( long long index = iBegin; index < iEnd; ++index ){
+				length += formatLine( lineType, index, buffer + length );
+			}
+#pragma omp ordered
+			fwrite( buffer, 1, length, fp );
+		}
+		delete [] buffer;
+	}
+
+}
+
+// Format a line of the specified type
+int SyntheticMeshGenerator::formatLine( const int lineType, const long long index, char* line ) const{
+
+	switch( lineType ){
+		case NODE:
+			{
+				const int iPlane = static_cast<int>( std::upper_bound( m_nodeOffsetOfPlanes.begin(), m_nodeOffsetOfPlanes.end(), index ) - m_nodeOffsetOfPlanes.begin() ) - 1;
+				const long long iNodeOfPlane = index - m_nodeOffsetOfPlanes[iPlane];
+				const int ix = static_cast<int>( iNodeOfPlane % m_numNodeXOfPlanes[iPlane] );
+				const int iy = static_cast<int>( iNodeOfPlane / m_numNodeXOfPlanes[iPlane] );
+				const double dx = m_params.cellSize * m_params.numCellsX / static_cast<double>( m_numNodeXOfPlanes[iPlane] - 1 );
+				const double dy = m_params.cellSize * m_params.numCellsY / static_cast<double>( m_numNodeYOfPlanes[iPlane] - 1 );
+				const double x = - 0.5 * m_params.cellSize * m_params.numCellsX + dx * ix;
+				const double y = - 0.5 * m_params.cellSize * m_params.numCellsY + dy * iy;
+				const double z = m_params.layerThickness * ( iPlane - m_params.numAirLayers );
+				return sprintf( line, "%lld %15.8e %15.8e %15.8e\n", index, x, y, z );
+			}
+		case ELEMENT:
+			if( m_params.meshType == MeshData::TETRA ){
+				return formatTetraElement( index, line );
+			}
+			return formatHexaElement( index, line );
+		case ELEMENT_TO_BLOCK:
+			return sprintf( line, "%10lld%10d\n", index, getBlockFromElement(index) );
+		case BLOCK:
+			if( index == 0 ){
+				// Air
+				return sprintf( line, "%10d%5s%15e%15e%15e%15e%10d\n", 0, "     ", 1.0e+9, 1.0e-20, 1.0e+20, 1.0, ResistivityBlock::FIXED_AND_ISOLATED );
+			}
+			return sprintf( line, "%10lld%5s%15e%15e%15e%15e%10d\n", index, "     ", getResistivityOfBlock( static_cast<int>(index) ),
+				1.0e-20, 1.0e+20, 1.0, ResistivityBlock::FREE_AND_CONSTRAINED );
+		default:
+			std::cerr << "Error : Type of line is wrong : " << lineType << std::endl;
+			exit(1);
+	}
+
+}
+
+// Format a line of an element of tetrahedral mesh
+// The vertices of the tetrahedron are visited from the corner of the cell with the minimum indexes along
+// the axes a, b and c in order. The faces opposite to the first and last vertices are on the faces of the cell,
+// and the others are shared with the tetrahedra of the same cell. The second and third vertices are swapped
+// for the odd permutations so that the volume is positive.
+int SyntheticMeshGenerator::formatTetraElement( const long long iElem, char* line ) const{
+
+	int iLayer(0);
+	int ix(0);
+	int iy(0);
+	getIndexesOfElement( iElem, iLayer, ix, iy );
+	const long long iFirstElemOfCell = iElem - iElem % 6;
+	const int iTetra = static_cast<int>( iElem % 6 );
+	const int a = axesOfTetra[iTetra][0];
+	const int b = axesOfTetra[iTetra][1];
+	const int c = axesOfTetra[iTetra][2];
+	const int numCells[3] = { m_params.numCellsX, m_params.numCellsY, m_params.numCellsZ };
+
+	// Vertices in the order of visiting
+	int vertices[4][3] = { { ix, iy, iLayer }, { ix, iy, iLayer }, { ix, iy, iLayer }, { ix + 1, iy + 1, iLayer + 1 } };
+	vertices[1][a] += 1;
+	vertices[2][a] += 1;
+	vertices[2][b] += 1;
+
+	// Neighbor elements across the faces opposite to the vertices
+	long long neighbors[4] = { -1, -1, -1, -1 };
+	int cell[3] = { ix, iy, iLayer };
+	cell[a] += 1;
+	if( cell[a] < numCells[a] ){
+		neighbors[0] = getElementIndex( cell[2], cell[0], cell[1] ) + getTetraIndex(b, c, a);
+	}
+	neighbors[1] = iFirstElemOfCell + getTetraIndex(b, a, c);
+	neighbors[2] = iFirstElemOfCell + getTetraIndex(a, c, b);
+	cell[a] -= 1;
+	cell[c] -= 1;
+	if( cell[c] >= 0 ){
+		neighbors[3] = getElementIndex( cell[2], cell[0], cell[1] ) + getTetraIndex(c, a, b);
+	}
+
+	const int order[4] = { 0, isOddPermutation(iTetra) ? 2 : 1, isOddPermutation(iTetra) ? 1 : 2, 3 };
+	long long nodes[4];
+	for( int i = 0; i < 4; ++i ){
+		const int* vertex = vertices[ order[i] ];
+		nodes[i] = getNodeIndex( vertex[2], vertex[0], vertex[1] );
+	}
+	return sprintf( line, "%lld %lld %lld %lld %lld %lld %lld %lld %lld\n", iElem,
+		neighbors[order[0]], neighbors[order[1]], neighbors[order[2]], neighbors[order[3]],
+		nodes[0], nodes[1], nodes[2], nodes[3] );
+
+}
+
+// Format a line of an element of nonconforming hexahedral mesh
+int SyntheticMeshGenerator::formatHexaElement( const long long iElem, char* line ) const{
+
+	int iLayer(0);
+	int ix(0);
+	int iy(0);
+	getIndexesOfElement( iElem, iLayer, ix, iy );
+
+	// Nodes on the upper and lower planes
+	int length = sprintf( line, "%lld", iElem );
+	for( int iPlane = iLayer; iPlane <= iLayer + 1; ++iPlane ){
+		const int ratio = ( m_numNodeXOfPlanes[iPlane] - 1 ) / m_numElemXOfLayers[iLayer];
+		const int x0 = ix * ratio;
+		const int y0 = iy * ratio;
+		length += sprintf( line + length, " %lld %lld %lld %lld",
+			getNodeIndex( iPlane, x0, y0 ), getNodeIndex( iPlane, x0 + ratio, y0 ),
+			getNodeIndex( iPlane, x0 + ratio, y0 + ratio ), getNodeIndex( iPlane, x0, y0 + ratio ) );
+	}
+
+	// Neighbor elements of the side faces
+	const int numElemX = m_numElemXOfLayers[iLayer];
+	const int numElemY = m_numElemYOfLayers[iLayer];
+	const int sideX[4] = { ix - 1, ix + 1, ix, ix };
+	const int sideY[4] = { iy, iy, iy - 1, iy + 1 };
+	for( int iFace = 0; iFace < 4; ++iFace ){
+		if( sideX[iFace] < 0 || sideX[iFace] >= numElemX || sideY[iFace] < 0 || sideY[iFace] >= numElemY ){
+			length += sprintf( line + length, " 0" );
+		}else{
+			length += sprintf( line + length, " 1 %lld", getElementIndex( iLayer, sideX[iFace], sideY[iFace] ) );
+		}
+	}
+
+	// Neighbor elements of the upper and lower faces
+	for( int iLayerNeib = iLayer - 1; iLayerNeib <= iLayer + 1; iLayerNeib += 2 ){
+		if( iLayerNeib < 0 || iLayerNeib >= m_params.numCellsZ ){
+			length += sprintf( line + length, " 0" );
+		}else if( m_numElemXOfLayers[iLayerNeib] > numElemX ){
+			// Four refined elements
+			length += sprintf( line + length, " 4 %lld %lld %lld %lld",
+				getElementIndex( iLayerNeib, 2 * ix, 2 * iy ), getElementIndex( iLayerNeib, 2 * ix + 1, 2 * iy ),
+				getElementIndex( iLayerNeib, 2 * ix, 2 * iy + 1 ), getElementIndex( iLayerNeib, 2 * ix + 1, 2 * iy + 1 ) );
+		}else if( m_numElemXOfLayers[iLayerNeib] < numElemX ){
+			length += sprintf( line + length, " 1 %lld", getElementIndex( iLayerNeib, ix / 2, iy / 2 ) );
+		}else{
+			length += sprintf( line + length, " 1 %lld", getElementIndex( iLayerNeib, ix, iy ) );
+		}
+	}
+	length += sprintf( line + length, "\n" );
+
+	return length;
+
+}
+
+// Get layer and horizontal indexes of an element
+void SyntheticMeshGenerator::getIndexesOfElement( const long long iElem, int& iLayer, int& ix, int& iy ) const{
+
+	iLayer = static_cast<int>( std::upper_bound( m_elemOffsetOfLayers.begin(), m_elemOffsetOfLayers.end(), iElem ) - m_elemOffsetOfLayers.begin() ) - 1;
+	long long iCellOfLayer = iElem - m_elemOffsetOfLayers[iLayer];
+	if( m_params.meshType == MeshData::TETRA ){
+		iCellOfLayer /= 6;
+	}
+	ix = static_cast<int>( iCellOfLayer % m_numElemXOfLayers[iLayer] );
+	iy = static_cast<int>( iCellOfLayer / m_numElemXOfLayers[iLayer] );
+
+}
+
+// Get index of an element from its layer and horizontal indexes
+// [note] : The index of the first tetrahedron of the cell is returned for tetrahedral mesh
+long long SyntheticMeshGenerator::getElementIndex( const int iLayer, const int ix, const int iy ) const{
+	const long long iCellOfLayer = static_cast<long long>(iy) * m_numElemXOfLayers[iLayer] + ix;
+	return m_elemOffsetOfLayers[iLayer] + ( m_params.meshType == MeshData::TETRA ? 6 * iCellOfLayer : iCellOfLayer );
+}
+
+// Get index of a node from its plane and horizontal indexes
+long long SyntheticMeshGenerator::getNodeIndex( const int iPlane, const int ix, const int iy ) const{
+	return m_nodeOffsetOfPlanes[iPlane] + static_cast<long long>(iy) * m_numNodeXOfPlanes[iPlane] + ix;
+}
+
+// Get resistivity block of an element
+// The earth is divided into the blocks of the cells of the coarse grid
+int SyntheticMeshGenerator::getBlockFromElement( const long long iElem ) const{
+
+	int iLayer(0);
+	int ix(0);
+	int iy(0);
+	getIndexesOfElement( iElem, iLayer, ix, iy );
+	if( iLayer < m_params.numAirLayers ){
+		return 0;
+	}
+	if( isRefinedLayer(iLayer) ){
+		ix /= 2;
+		iy /= 2;
+	}
+	const int ib = ix / m_params.numCellsOfBlock;
+	const int jb = iy / m_params.numCellsOfBlock;
+	const int kb = ( iLayer - m_params.numAirLayers ) / m_params.numCellsOfBlock;
+	return 1 + ( kb * m_numBlocksY + jb ) * m_numBlocksX + ib;
+
+}
+
+// Get resistivity value of an earth block
+// The common logarithm of the resistivity is distributed uniformly from 0 to 3 by the hash of the block index
+double SyntheticMeshGenerator::getResistivityOfBlock( const int iBlk ) const{
+
+	unsigned long long hash = ( static_cast<unsigned long long>( m_params.seed ) << 32 ) + static_cast<unsigned long long>(iBlk);
+	hash += 0x9E3779B97F4A7C15ULL;
+	hash = ( hash ^ ( hash >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+	hash = ( hash ^ ( hash >> 27 ) ) * 0x94D049BB133111EBULL;
+	hash = hash ^ ( hash >> 31 );
+	const double uniform = static_cast<double>( hash >> 11 ) / 9007199254740992.0;
+	return pow( 10.0, 3.0 * uniform );
+
+}
+
+// Write boundary planes and land surface of tetrahedral mesh
+// The faces opposite to the last vertices are on the minus sides of the cells along the axis c,
+// and the faces opposite to the first vertices are on the plus sides of the cells along the axis a.
+void SyntheticMeshGenerator::writeBoundaryFacesOfTetra( FILE* fp ) const{
+
+	const int numCells[3] = { m_params.numCellsX, m_params.numCellsY, m_params.numCellsZ };
+	for( int iPlane = 0; iPlane < 6; ++iPlane ){
+		const int axis = iPlane / 2;
+		const bool isPlusSide = iPlane % 2 == 1;
+		const long long numFaces = 2LL * numCells[0] * numCells[1] * numCells[2] / numCells[axis];
+		fprintf(fp, "%lld\n", numFaces );
+		int begin[3] = { 0, 0, 0 };
+		int end[3] = { numCells[0], numCells[1], numCells[2] };
+		begin[axis] = isPlusSide ? numCells[axis] - 1 : 0;
+		end[axis] = begin[axis] + 1;
+		for( int iz = begin[2]; iz < end[2]; ++iz ){
+			for( int iy = begin[1]; iy < end[1]; ++iy ){
+				for( int ix = begin[0]; ix < end[0]; ++ix ){
+					for( int iTetra = 0; iTetra < 6; ++iTetra ){
+						if( isPlusSide && axesOfTetra[iTetra][0] == axis ){
+							fprintf(fp, "%lld %d\n", getElementIndex(iz, ix, iy) + iTetra, 0 );
+						}else if( !isPlusSide && axesOfTetra[iTetra][2] == axis ){
+							fprintf(fp, "%lld %d\n", getElementIndex(iz, ix, iy) + iTetra, 3 );
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// Land surface is the top of the uppermost earth layer
+	fprintf(fp, "%lld\n", 2LL * numCells[0] * numCells[1] );
+	const int iLayer = m_params.numAirLayers;
+	for( int iy = 0; iy < numCells[1]; ++iy ){
+		for( int ix = 0; ix < numCells[0]; ++ix ){
+			for( int iTetra = 0; iTetra < 6; ++iTetra ){
+				if( axesOfTetra[iTetra][2] == 2 ){
+					fprintf(fp, "%lld %d\n", getElementIndex(iLayer, ix, iy) + iTetra, 3 );
+				}
+			}
+		}
+	}
+
+}
+
+// Write boundary planes and land surface of nonconforming hexahedral mesh
+void SyntheticMeshGenerator::writeBoundaryFacesOfHexa( FILE* fp ) const{
+
+	const int numLayers = m_params.numCellsZ;
+	for( int iPlane = 0; iPlane < 4; ++iPlane ){
+		const bool isYZPlane = iPlane < 2;
+		long long numFaces(0);
+		for( int iLayer = 0; iLayer < numLayers; ++iLayer ){
+			numFaces += isYZPlane ? m_numElemYOfLayers[iLayer] : m_numElemXOfLayers[iLayer];
+		}
+		fprintf(fp, "%lld\n", numFaces );
+		for( int iLayer = 0; iLayer < numLayers; ++iLayer ){
+			const int numElemX = m_numElemXOfLayers[iLayer];
+			const int numElemY = m_numElemYOfLayers[iLayer];
+			if( isYZPlane ){
+				const int ix = iPlane == 0 ? 0 : numElemX - 1;
+				for( int iy = 0; iy < numElemY; ++iy ){
+					fprintf(fp, "%lld %d\n", getElementIndex(iLayer, ix, iy), iPlane );
+				}
+			}else{
+				const int iy = iPlane == 2 ? 0 : numElemY - 1;
+				for( int ix = 0; ix < numElemX; ++ix ){
+					fprintf(fp, "%lld %d\n", getElementIndex(iLayer, ix, iy), iPlane );
+				}
+			}
+		}
+	}
+
+	// Top and bottom of the mesh and the land surface
+	const int layers[3] = { 0, numLayers - 1, m_params.numAirLayers };
+	const int faces[3] = { 4, 5, 4 };
+	for( int i = 0; i < 3; ++i ){
+		const int iLayer = layers[i];
+		fprintf(fp, "%lld\n", m_elemOffsetOfLayers[iLayer + 1] - m_elemOffsetOfLayers[iLayer] );
+		for( long long iElem = m_elemOffsetOfLayers[iLayer]; iElem < m_elemOffsetOfLayers[iLayer + 1]; ++iElem ){
+			fprintf(fp, "%lld %d\n", iElem, faces[i] );
+		}
+	}
+
+}
@@ -0,0 +1,171 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#ifndef DBLDEF_SYNTHETIC_MESH_GENERATOR
+#define DBLDEF_SYNTHETIC_MESH_GENERATOR
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+// Class generating mesh.dat and resistivity_block_iterN.dat of a synthetic model for benchmarking
+// The model consists of air layers above the land surface ( z = 0 ) and earth layers below it, and the
+// cells of a structured grid are numbered layer by layer. All the data are calculated analytically from
+// the indexes, so that the files can be written without holding the mesh in memory.
+//   TETRA : Each cell is divided into six tetrahedra sharing the diagonal of the cell ( Kuhn triangulation )
+//   DHEXA : The cells of the uppermost earth layers are refined by 2 x 2 horizontally. The faces on the
+//           interfaces between the refined and coarse layers have four neighbor elements.
+class SyntheticMeshGenerator{
+
+public:
+
+	// Parameters of the synthetic model
+	struct Parameters{
+		// Type of mesh
+		int meshType;
+		// Numbers of the cells along the axes including the air layers
+		int numCellsX;
+		int numCellsY;
+		int numCellsZ;
+		// Number of the air layers
+		int numAirLayers;
+		// Number of the earth layers refined horizontally ( DHEXA only )
+		int numRefinedLayers;
+		// Horizontal size of the cells [m]
+		double cellSize;
+		// Thickness of the layers [m]
+		double layerThickness;
+		// Number of the cells of a resistivity block along each axis
+		int numCellsOfBlock;
+		// Seed of the resistivity values of the blocks
+		unsigned int seed;
+	};
+
+	// Constructer
+	explicit SyntheticMeshGenerator( const Parameters& params );
+
+	// Destructer
+	~SyntheticMeshGenerator();
+
+	// Calculate numbers of the cells whose number of elements is close to the specified one
+	// [note] : The cells are cubic and the numbers of the air and refined layers are set to one eighth of the layers
+	static void calcNumCellsFromNumElements( const int meshType, const long long numElemTarget, Parameters& params );
+
+	// Get total number of elements
+	long long getNumElemTotal() const;
+
+	// Get total number of nodes
+	long long getNumNodeTotal() const;
+
+	// Get total number of resistivity blocks
+	int getNumResistivityBlockTotal() const;
+
+	// Write mesh data to file
+	void writeMeshData( const std::string& fileName ) const;
+
+	// Write resistivity block model to file
+	void writeResistivityBlock( const std::string& fileName ) const;
+
+private:
+
+	// Copy constructer
+	SyntheticMeshGenerator(const SyntheticMeshGenerator& rhs);
+
+	// Copy assignment operator
+	SyntheticMeshGenerator& operator=(const SyntheticMeshGenerator& rhs);
+
+	enum LineTypes{
+		NODE = 0,
+		ELEMENT,
+		ELEMENT_TO_BLOCK,
+		BLOCK,
+	};
+
+	// Number of lines formatted at once by a thread
+	static const int m_numLinesOfChunk = 8192;
+
+	// Maximum length of a line
+	static const int m_maxLineLength = 512;
+
+	// Parameters of the model
+	Parameters m_params;
+
+	// Numbers of the elements along X and Y axes in each layer
+	std::vector<int> m_numElemXOfLayers;
+	std::vector<int> m_numElemYOfLayers;
+
+	// Index of the first element of each layer ( the last entry is the total number of elements )
+	std::vector<long long> m_elemOffsetOfLayers;
+
+	// Numbers of the nodes along X and Y axes in each node plane
+	std::vector<int> m_numNodeXOfPlanes;
+	std::vector<int> m_numNodeYOfPlanes;
+
+	// Index of the first node of each node plane ( the last entry is the total number of nodes )
+	std::vector<long long> m_nodeOffsetOfPlanes;
+
+	// Numbers of the resistivity blocks along the axes in the earth
+	int m_numBlocksX;
+	int m_numBlocksY;
+	int m_numBlocksZ;
+
+	// Check whether a layer is refined
+	bool isRefinedLayer( const int iLayer ) const;
+
+	// Write lines of the specified type in parallel
+	// [note] : Each chunk of the lines is formatted by a thread and the chunks are written in order
+	void writeLines( FILE* fp, const int lineType, const long long numLines ) const;
+
+	// Format a line of the specified type
+	int formatLine( const int lineType, const long long index, char* line ) const;
+
+	// Format a line of an element of tetrahedral mesh
+	int formatTetraElement( const long long iElem, char* line ) const;
+
+	// Format a line of an element of nonconforming hexahedral mesh
+	int formatHexaElement( const long long iElem, char* line ) const;
+
+	// Get layer and horizontal indexes of an element
+	void getIndexesOfElement( const long long iElem, int& iLayer, int& ix, int& iy ) const;
+
+	// Get index of an element from its layer and horizontal indexes
+	long long getElementIndex( const int iLayer, const int ix, const int iy ) const;
+
+	// Get index of a node from its plane and horizontal indexes
+	long long getNodeIndex( const int iPlane, const int ix, const int iy ) const;
+
+	// Get resistivity block of an element
+	int getBlockFromElement( const long long iElem ) const;
+
+	// Get resistivity value of an earth block
+	double getResistivityOfBlock( const int iBlk ) const;
+
+	// Write boundary planes and land surface of tetrahedral mesh
+	void writeBoundaryFacesOfTetra( FILE* fp ) const;
+
+	// Write boundary planes and land surface of nonconforming hexahedral mesh
+	void writeBoundaryFacesOfHexa( FILE* fp ) const;
+
+};
+
+#endif
@@ -0,0 +1,192 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <set>
+#include <stdlib.h>
+#ifdef _LINUX
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+#ifdef _USE_OMP
+#include <omp.h>
+#endif
+
+#include "Tracer.h"
+#include "PerformanceReport.h"
+
+bool Tracer::m_enabled = false;
+
+double Tracer::m_timeOrigin = 0.0;
+
+std::vector<Tracer::EventRecord> Tracer::m_events;
+
+// Constructer
+Tracer::Event::Event( const char* category, const char* name ):
+	m_category(category),
+	m_name(),
+	m_start(0.0)
+{
+	if( m_enabled ){
+		m_name = name;
+		m_start = PerformanceReport::getWallTime();
+	}
+}
+
+// Constructer with name made at run time
+Tracer::Event::Event( const char* category, const std::string& name ):
+	m_category(category),
+	m_name(),
+	m_start(0.0)
+{
+	if( m_enabled ){
+		m_name = name;
+		m_start = PerformanceReport::getWallTime();
+	}
+}
+
+// Destructer
+Tracer::Event::~Event(){
+	if( m_enabled && !m_name.empty() ){
+		addEvent( m_category, m_name, m_start, PerformanceReport::getWallTime() );
+	}
+}
+
+// Copy constructer
+Tracer::Event::Event(const Event& rhs){
+	std::cerr << "Error : Copy constructer of the class Tracer::Event is not implemented." << std::endl;
+	exit(1);
+}
+
+// Assignment operator
+Tracer::Event& Tracer::Event::operator=(const Event& rhs){
+	std::cerr << "Error : Assignment operator of the class Tracer::Event is not implemented." << std::endl;
+	exit(1);
+}
+
+// Constructer
+Tracer::Tracer(){
+}
+
+// Enable the tracer
+void Tracer::enable(){
+	m_timeOrigin = PerformanceReport::getWallTime();
+	m_enabled = true;
+}
+
+// Get flag specifing whether the tracer is enabled
+bool Tracer::isEnabled(){
+	return m_enabled;
+}
+
+// Add event of the calling thread between the specified wall clock times
+void Tracer::addEvent( const char* category, const std::string& name, const double start, const double end ){
+
+	if( !m_enabled ){
+		return;
+	}
+
+	EventRecord record;
+	record.category = category;
+	record.name = name;
+	record.start = start;
+	record.end = end;
+	record.threadID = getThreadID();
+	record.threadNum = 0;
+	record.level = 0;
+#ifdef _USE_OMP
+	record.threadNum = omp_get_thread_num();
+	record.level = omp_get_level();
+#endif
+
+#pragma omp critical (addTraceEvent)
+	m_events.push_back(record);
+
+}
+
+// Output trace to file in Chrome trace format
+void Tracer::outputTrace( const std::string& fileName ){
+
+	std::ofstream ofs( fileName.c_str(), std::ios::out | std::ios::trunc );
+	if( ofs.fail() ){
+		std::cerr << "File open error : " << fileName << " !!" << std::endl;
+		exit(1);
+	}
+
+	ofs << std::fixed << std::setprecision(3);
+	ofs << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [" << std::endl;
+	ofs << "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 0, \"args\": {\"name\": \"changeResistivity\"}}";
+
+	// Threads are named by their thread numbers at their first events
+	std::set<long long> threadsNamed;
+	for( std::vector<EventRecord>::const_iterator itr = m_events.begin(); itr != m_events.end(); ++itr ){
+		if( threadsNamed.insert( itr->threadID ).second ){
+			ofs << "," << std::endl;
+			ofs << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << itr->threadID
+				<< ", \"args\": {\"name\": \"thread " << itr->threadNum << " ( level " << itr->level << " )\"}}";
+		}
+	}
+
+	// Complete events with durations in microsecond
+	for( std::vector<EventRecord>::const_iterator itr = m_events.begin(); itr != m_events.end(); ++itr ){
+		ofs << "," << std::endl;
+		ofs << "{\"name\": \"";
+		writeEscapedString( ofs, itr->name );
+		ofs << "\", \"cat\": \"" << itr->category << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << itr->threadID
+			<< ", \"ts\": " << ( itr->start - m_timeOrigin ) * 1.0e6
+			<< ", \"dur\": " << ( itr->end - itr->start ) * 1.0e6 << "}";
+	}
+
+	ofs << std::endl << "]}" << std::endl;
+	ofs.close();
+
+}
+
+// Get ID of the calling thread
+long long Tracer::getThreadID(){
+#ifdef _LINUX
+	return static_cast<long long>( syscall( SYS_gettid ) );
+#elif defined(_USE_OMP)
+	return static_cast<long long>( omp_get_level() ) * 10000 + omp_get_thread_num();
+#else
+	return 0;
+#endif
+}
+
+// Write string escaped for JSON
+void Tracer::writeEscapedString( std::ostream& ofs, const std::string& str ){
+
+	for( std::string::const_iterator itr = str.begin(); itr != str.end(); ++itr ){
+		if( *itr == '"' || *itr == '\\' ){
+			ofs << '\\';
+		}
+		if( static_cast<unsigned char>(*itr) < 0x20 ){
+			ofs << ' ';
+		}else{
+			ofs << *itr;
+		}
+	}
+
+}
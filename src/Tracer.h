@@ -0,0 +1,121 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#ifndef DBLDEF_TRACER
+#define DBLDEF_TRACER
+
+#include <string>
+#include <vector>
+
+// Class of tracer recording the events of the threads in Chrome trace format
+// The trace can be inspected with a trace viewer such as chrome://tracing or Perfetto.
+// [note] : Events are recorded only after the tracer is enabled. The phases of PerformanceReport are recorded as well.
+class Tracer{
+
+public:
+
+	// Class of event recorded from its construction to its destruction on the calling thread
+	class Event{
+
+	public:
+
+		// Constructer
+		Event( const char* category, const char* name );
+
+		// Constructer with name made at run time
+		Event( const char* category, const std::string& name );
+
+		// Destructer
+		~Event();
+
+	private:
+
+		// Copy constructer
+		Event(const Event& rhs);
+
+		// Copy assignment operator
+		Event& operator=(const Event& rhs);
+
+		// Category of the event
+		const char* m_category;
+
+		// Name of the event
+		// [note] : This is empty if the tracer is not enabled
+		std::string m_name;
+
+		// Wall clock time at the start
+		double m_start;
+
+	};
+
+	// Enable the tracer
+	static void enable();
+
+	// Get flag specifing whether the tracer is enabled
+	static bool isEnabled();
+
+	// Add event of the calling thread between the specified wall clock times
+	static void addEvent( const char* category, const std::string& name, const double start, const double end );
+
+	// Output trace to file in Chrome trace format
+	static void outputTrace( const std::string& fileName );
+
+private:
+
+	// Constructer
+	Tracer();
+
+	// Event recorded
+	struct EventRecord{
+		// Category of the event
+		const char* category;
+		// Name of the event
+		std::string name;
+		// Wall clock times of the start and the end
+		double start;
+		double end;
+		// ID of the thread given by the operating system
+		long long threadID;
+		// Thread number in the team and nesting level of the parallel region
+		int threadNum;
+		int level;
+	};
+
+	// Flag specifing whether the tracer is enabled
+	static bool m_enabled;
+
+	// Wall clock time at which the tracer is enabled
+	static double m_timeOrigin;
+
+	// Events recorded
+	static std::vector<EventRecord> m_events;
+
+	// Get ID of the calling thread
+	static long long getThreadID();
+
+	// Write string escaped for JSON
+	static void writeEscapedString( std::ostream& ofs, const std::string& str );
+
+};
+
+#endif
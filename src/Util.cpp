@@ -26,6 +26,10 @@
 #include <stdio.h>
 #include <math.h>
 #include <vector>
+#include <string.h>
+#ifdef _USE_OMP
+#include <omp.h>
+#endif
 
 // Sort elements by its key value with quick sort
 // cf) Numerical Recipes in C++ Second Edition, p336-p339.
@@ -256,6 +260,126 @@ void quickSortThreeKeys( const int numOfIDs, int* ids,
 
 }
 
+// Sort elements by its 64-bit unsigned integer key with parallel radix sort
+// Least significant digit radix sort with 8-bit digits. Each pass counts digits in
+// per-thread histograms and scatters elements stably. Passes in which all the
+// elements have the same digit are skipped.
+// [Input]:
+//   1) numOfIDs: Number of elements to be sorted
+//   2)     keys: Key values of each element. Elements are sorted by this values.
+// [Input/Output]:
+//   1)      ids: Array of elements to be sorted
+void radixSort( const int numOfIDs, int* ids, const unsigned long long* keys ){
+
+	if( ids == NULL ){
+		std::cerr << "Error : ids is NULL in radixSort !!" << std::endl;
+		exit(1);
+	}
+	if( keys == NULL ){
+		std::cerr << "Error : keys is NULL in radixSort !!" << std::endl;
+		exit(1);
+	}
+	if( numOfIDs <= 0 ){
+		std::cerr << "Error : numOfIDs is equal to or less than zero in radixSort !!" << std::endl;
+		exit(1);
+	}
+
+	const int numBuckets = 256;
+	const int numPasses = 8;
+#ifdef _USE_OMP
+	const int numThreads = omp_get_max_threads();
+#else
+	const int numThreads = 1;
+#endif
+
+	std::vector<int> idsBuf(numOfIDs);
+	std::vector<unsigned long long> keysSorted(numOfIDs);
+	std::vector<unsigned long long> keysBuf(numOfIDs);
+	for( int i = 0; i < numOfIDs; ++i ){
+		keysSorted[i] = keys[ids[i]];
+	}
+	int* idsSrc = ids;
+	int* idsDst = &idsBuf[0];
+	unsigned long long* keysSrc = &keysSorted[0];
+	unsigned long long* keysDst = &keysBuf[0];
+
+	std::vector<int> counts( numThreads * numBuckets );
+	for( int iPass = 0; iPass < numPasses; ++iPass ){
+		const int shift = 8 * iPass;
+		bool skipPass(false);
+#pragma omp parallel num_threads(numThreads)
+		{
+#ifdef _USE_OMP
+			const int iThread = omp_get_thread_num();
+#else
+			const int iThread = 0;
+#endif
+			const int iBegin = static_cast<int>( static_cast<long long>(numOfIDs) * iThread / numThreads );
+			const int iEnd = static_cast<int>( static_cast<long long>(numOfIDs) * ( iThread + 1 ) / numThreads );
+			int* countsThread = &counts[ iThread * numBuckets ];
+			memset( countsThread, 0, sizeof(int) * numBuckets );
+			for( int i = iBegin; i < iEnd; ++i ){
+				++countsThread[ ( keysSrc[i] >> shift ) & 0xFF ];
+			}
+#pragma omp barrier
+#pragma omp single
+			{
+				// Convert counts to the first position of each digit and thread
+				int offset(0);
+				for( int iBucket = 0; iBucket < numBuckets; ++iBucket ){
+					int numInBucket(0);
+					for( int jThread = 0; jThread < numThreads; ++jThread ){
+						const int icount = counts[ jThread * numBuckets + iBucket ];
+						counts[ jThread * numBuckets + iBucket ] = offset;
+						offset += icount;
+						numInBucket += icount;
+					}
+					if( numInBucket == numOfIDs ){
+						skipPass = true;
+					}
+				}
+			}
+			if( !skipPass ){
+				for( int i = iBegin; i < iEnd; ++i ){
+					const int pos = countsThread[ ( keysSrc[i] >> shift ) & 0xFF ]++;
+					idsDst[pos] = idsSrc[i];
+					keysDst[pos] = keysSrc[i];
+				}
+			}
+		}
+		if( !skipPass ){
+			std::swap( idsSrc, idsDst );
+			std::swap( keysSrc, keysDst );
+		}
+	}
+
+	if( idsSrc != ids ){
+		memcpy( ids, idsSrc, sizeof(int) * numOfIDs );
+	}
+
+	return;
+
+}
+
+// Calculate Morton code by interleaving bits of three 21-bit integer coordinates
+unsigned long long calcMortonCode( const unsigned int ix, const unsigned int iy, const unsigned int iz ){
+
+	unsigned long long coord[3] = { ix, iy, iz };
+	for( int i = 0; i < 3; ++i ){
+		// Spread the lower 21 bits so that two zero bits are inserted between each bit
+		unsigned long long val = coord[i] & 0x1FFFFFULL;
+		val = ( val | ( val << 32 ) ) & 0x1F00000000FFFFULL;
+		val = ( val | ( val << 16 ) ) & 0x1F0000FF0000FFULL;
+		val = ( val | ( val << 8 ) )  & 0x100F00F00F00F00FULL;
+		val = ( val | ( val << 4 ) )  & 0x10C30C30C30C30C3ULL;
+		val = ( val | ( val << 2 ) )  & 0x1249249249249249ULL;
+		coord[i] = val;
+	}
+
+	return coord[0] | ( coord[1] << 1 ) | ( coord[2] << 2 );
+
+}
+
 // Compare values by its three keys
 int compareValueByThreeKeys( const int lhsID, const int rhsID, 
 	const double* firstKeyValues, const double* secondKeyValues, const double* thirdKeyValues ) {
@@ -290,6 +414,120 @@ int compareValueByThreeKeys( const int lhsID, const int rhsID,
 
 }
 
+// Get abscissas and weights of Gauss quadrature of the specified number of points
+void getGaussQuadrature( const int numGauss, const double*& abscissas, const double*& weights ){
+
+	switch(numGauss){
+		case 1:
+			abscissas = CommonParameters::abscissas1Point;
+			weights = CommonParameters::weights1Point;
+			break;
+		case 2:
+			abscissas = CommonParameters::abscissas2Point;
+			weights = CommonParameters::weights2Point;
+			break;
+		case 3:
+			abscissas = CommonParameters::abscissas3Point;
+			weights = CommonParameters::weights3Point;
+			break;
+		default:
+			std::cerr << "Error : Number of points of Gauss quadrature must be 1, 2 or 3 !! : " << numGauss << std::endl;
+			exit(1);
+			break;
+	}
+
+}
+
+// Calculate integral of P(v)^2 / ( 2 * D(v) ) from va to vb for linear functions P and D
+// [note] : D must be positive in the interval and 0 <= P <= D must hold, so that D can vanish
+//          at an end of the interval only where P vanishes as well
+static double calcIntegralOfSquareOverLinearFunction( const double p0, const double p1, const double d0, const double d1, const double va, const double vb ){
+
+	const double Da = d0 + d1 * va;
+	const double Db = d0 + d1 * vb;
+	const double scale = std::max( fabs(p0) + fabs(p1), fabs(d0) + fabs(d1) );
+	if( fabs(d1) <= 1.0e-12 * scale || fabs( Db - Da ) <= 1.0e-3 * std::min( fabs(Da), fabs(Db) ) ){
+		// The integrand is almost quadratic. Three point Gauss quadrature is exact within round-off error.
+		double val(0.0);
+		for( int i = 0; i < 3; ++i ){
+			const double v = 0.5 * ( va + vb ) + 0.5 * ( vb - va ) * CommonParameters::abscissas3Point[i];
+			const double P = p0 + p1 * v;
+			val += CommonParameters::weights3Point[i] * P * P / ( 2.0 * ( d0 + d1 * v ) );
+		}
+		return 0.5 * ( vb - va ) * val;
+	}
+
+	// Substitute w = D(v) and P = alpha + beta * w
+	const double beta = p1 / d1;
+	const double alpha = p0 - beta * d0;
+	if( std::min( Da, Db ) <= 1.0e-12 * scale ){
+		// P and D vanish at the same end, where alpha tends to zero faster than log( Db / Da ) diverges
+		return ( 2.0 * alpha * beta * ( Db - Da ) + 0.5 * beta * beta * ( Db * Db - Da * Da ) ) / ( 2.0 * d1 );
+	}
+	return ( alpha * alpha * log( Db / Da ) + 2.0 * alpha * beta * ( Db - Da ) + 0.5 * beta * beta * ( Db * Db - Da * Da ) ) / ( 2.0 * d1 );
+
+}
+
+// Calculate integral of the positive part of a bilinear function over the unit square
+// f(u,v) = f00*(1-u)*(1-v) + f10*u*(1-v) + f01*(1-u)*v + f11*u*v is linear in u for fixed v.
+// Its positive part integrated over u is a piecewise rational function of v, whose pieces are
+// separated by the roots of A(v) = f(0,v) and C(v) = f(1,v). Each piece is integrated analytically.
+// [Input]:
+//   1) f00, f10, f01, f11: Values of the function at the corners of the unit square
+// [Output]:
+//   1) Integral of max( f(u,v), 0 ) over the unit square
+double calcIntegralOfPositivePartOfBilinearFunction( const double f00, const double f10, const double f01, const double f11 ){
+
+	if( f00 >= 0.0 && f10 >= 0.0 && f01 >= 0.0 && f11 >= 0.0 ){
+		return 0.25 * ( f00 + f10 + f01 + f11 );
+	}
+	if( f00 <= 0.0 && f10 <= 0.0 && f01 <= 0.0 && f11 <= 0.0 ){
+		return 0.0;
+	}
+
+	// A(v) = a0 + a1 * v, C(v) = c0 + c1 * v
+	const double a0 = f00;
+	const double a1 = f01 - f00;
+	const double c0 = f10;
+	const double c1 = f11 - f10;
+
+	double breakPoints[4] = { 0.0, 1.0, 1.0, 1.0 };
+	int numBreakPoints(1);
+	if( a0 * ( a0 + a1 ) < 0.0 ){
+		breakPoints[numBreakPoints++] = - a0 / a1;
+	}
+	if( c0 * ( c0 + c1 ) < 0.0 ){
+		breakPoints[numBreakPoints++] = - c0 / c1;
+	}
+	breakPoints[numBreakPoints++] = 1.0;
+	std::sort( breakPoints, breakPoints + numBreakPoints );
+
+	double val(0.0);
+	for( int i = 0; i + 1 < numBreakPoints; ++i ){
+		const double va = breakPoints[i];
+		const double vb = breakPoints[i+1];
+		if( vb - va <= 0.0 ){
+			continue;
+		}
+		const double vMid = 0.5 * ( va + vb );
+		const double AMid = a0 + a1 * vMid;
+		const double CMid = c0 + c1 * vMid;
+		if( AMid >= 0.0 && CMid >= 0.0 ){
+			// Integral of ( A + C ) / 2, which is linear in v
+			val += 0.5 * ( AMid + CMid ) * ( vb - va );
+		}else if( AMid > 0.0 && CMid < 0.0 ){
+			// Integral of A^2 / ( 2 * ( A - C ) )
+			val += calcIntegralOfSquareOverLinearFunction( a0, a1, a0 - c0, a1 - c1, va, vb );
+		}else if( AMid < 0.0 && CMid > 0.0 ){
+			// Integral of C^2 / ( 2 * ( C - A ) )
+			val += calcIntegralOfSquareOverLinearFunction( c0, c1, c0 - a0, c1 - a1, va, vb );
+		}
+	}
+
+	return val;
+
+}
+
 // Calculate matrix product for 2 x 2 double matrix
 void calcProductFor2x2DoubleMatrix( const CommonParameters::DoubleMatrix2x2& matInA, const CommonParameters::DoubleMatrix2x2& matInB, CommonParameters::DoubleMatrix2x2& matOut ){
 
@@ -44,9 +44,21 @@ void quickSort( const int numOfIDs, int* ids, const double* values );
 void quickSortThreeKeys( const int numOfIDs, int* ids,
 	const double* firstKeyValues, const double* secondKeyValues, const double* thirdKeyValues );
 
+// Sort elements by its 64-bit unsigned integer key with parallel radix sort
+void radixSort( const int numOfIDs, int* ids, const unsigned long long* keys );
+
+// Calculate Morton code by interleaving bits of three 21-bit integer coordinates
+unsigned long long calcMortonCode( const unsigned int ix, const unsigned int iy, const unsigned int iz );
+
 // Compare values by its three keys
 int compareValueByThreeKeys( const int lhsID, const int rhsID, const double* firstKeyValues, const double* secondKeyValues, const double* thirdKeyValues );
 
+// Get abscissas and weights of Gauss quadrature of the specified number of points
+void getGaussQuadrature( const int numGauss, const double*& abscissas, const double*& weights );
+
+// Calculate integral of the positive part of a bilinear function over the unit square
+double calcIntegralOfPositivePartOfBilinearFunction( const double f00, const double f10, const double f01, const double f11 );
+
 // Calculate matrix product for 2 x 2 double matrix
 void calcProductFor2x2DoubleMatrix( const CommonParameters::DoubleMatrix2x2& matInA, const CommonParameters::DoubleMatrix2x2& matInB, CommonParameters::DoubleMatrix2x2& matOut );
 
@@ -0,0 +1,325 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Verifier.h"
+
+// Compare the selected elements with those selected by the reference implementation
+bool Verifier::compareSelectedElements( const std::set<int>& elementsReference, const std::set<int>& elementsSelected, std::ostream& ofsLog ){
+
+	int numMissing(0);
+	int numExtra(0);
+	std::set<int>::const_iterator itrRef = elementsReference.begin();
+	std::set<int>::const_iterator itr = elementsSelected.begin();
+	while( itrRef != elementsReference.end() || itr != elementsSelected.end() ){
+		if( itr == elementsSelected.end() || ( itrRef != elementsReference.end() && *itrRef < *itr ) ){
+			if( numMissing + numExtra < m_maxNumMismatchesReported ){
+				ofsLog << "Mismatch : element " << *itrRef << " is selected only by the reference implementation" << std::endl;
+			}
+			++numMissing;
+			++itrRef;
+		}else if( itrRef == elementsReference.end() || *itr < *itrRef ){
+			if( numMissing + numExtra < m_maxNumMismatchesReported ){
+				ofsLog << "Mismatch : element " << *itr << " is selected only by the optimized implementation" << std::endl;
+			}
+			++numExtra;
+			++itr;
+		}else{
+			++itrRef;
+			++itr;
+		}
+	}
+
+	if( numMissing + numExtra > 0 ){
+		ofsLog << "Verification of the selected elements failed : " << numMissing << " elements are missing and "
+			<< numExtra << " elements are extra among " << elementsReference.size() << " elements of the reference" << std::endl;
+		return false;
+	}
+	return true;
+
+}
+
+// Compare the modified resistivity block model with that modified by the reference implementation
+bool Verifier::compareResistivityBlocks( const int numElems, const ResistivityBlock& resistivityBlockReference,
+	const ResistivityBlockOverlay& resistivityBlockMod, std::ostream& ofsLog ){
+
+	int numElementsMismatched(0);
+	for( int iElem = 0; iElem < numElems; ++iElem ){
+		const int iBlkRef = resistivityBlockReference.getBlockFromElement(iElem);
+		const int iBlk = resistivityBlockMod.getBlockFromElement(iElem);
+		if( iBlk != iBlkRef ){
+			if( numElementsMismatched < m_maxNumMismatchesReported ){
+				ofsLog << "Mismatch : element " << iElem << " belongs to block " << iBlk
+					<< " while it belongs to block " << iBlkRef << " in the reference" << std::endl;
+			}
+			++numElementsMismatched;
+		}
+	}
+
+	const int numBlocksRef = resistivityBlockReference.getNumResistivityBlockTotal();
+	const int numBlocks = resistivityBlockMod.getNumResistivityBlockTotal();
+	if( numBlocks != numBlocksRef ){
+		ofsLog << "Mismatch : number of blocks is " << numBlocks << " while it is " << numBlocksRef << " in the reference" << std::endl;
+	}
+	int numBlocksMismatched(0);
+	for( int iBlk = 0; iBlk < std::min( numBlocks, numBlocksRef ); ++iBlk ){
+		const ResistivityBlock::ResistivityBlockInformation& infoRef = resistivityBlockReference.getResistivityBlockInformation(iBlk);
+		const ResistivityBlock::ResistivityBlockInformation& info = resistivityBlockMod.getResistivityBlockInformation(iBlk);
+		if( info.resistivityValue != infoRef.resistivityValue ||
+			info.resistivityValueMin != infoRef.resistivityValueMin ||
+			info.resistivityValueMax != infoRef.resistivityValueMax ||
+			info.weightingConstant != infoRef.weightingConstant ||
+			info.type != infoRef.type ){
+			if( numBlocksMismatched < m_maxNumMismatchesReported ){
+				ofsLog << "Mismatch : block " << iBlk << " has";
+				writeResistivityBlockInformation( info, ofsLog );
+				ofsLog << " while it has";
+				writeResistivityBlockInformation( infoRef, ofsLog );
+				ofsLog << " in the reference" << std::endl;
+			}
+			++numBlocksMismatched;
+		}
+	}
+
+	if( numElementsMismatched > 0 || numBlocksMismatched > 0 || numBlocks != numBlocksRef ){
+		ofsLog << "Verification of the modified model failed : " << numElementsMismatched << " elements and "
+			<< numBlocksMismatched << " blocks are mismatched" << std::endl;
+		return false;
+	}
+	return true;
+
+}
+
+// Compare the output files of the modified model with the model modified by the reference implementation
+bool Verifier::compareOutputFiles( const bool isTetra, const int numElems, const int iterNum, const std::string& prefix,
+	const ResistivityBlock& resistivityBlockReference, std::ostream& ofsLog ){
+
+	std::ostringstream blockFileName;
+	blockFileName << prefix << "resistivity_block_iter" << iterNum << ".mod.dat";
+	std::ostringstream valueFileName;
+	valueFileName << prefix << "ResistivityMod.iter" << iterNum;
+
+	// Both files are compared even if the first one is mismatched
+	const bool isBlockFileVerified = compareResistivityBlockFile(numElems, blockFileName.str(), resistivityBlockReference, ofsLog);
+	const bool isValueFileVerified = compareResistivityValueFile(isTetra, numElems, valueFileName.str(), resistivityBlockReference, ofsLog);
+	return isBlockFileVerified && isValueFileVerified;
+
+}
+
+// Change resistivity of the selected elements by the reference implementation and compare the model with the modified model
+bool Verifier::verifyModification( const int numElems, const ResistivityBlock& resistivityBlock, const std::set<int>& elementsSelected,
+	const double resistivityMod, const double resistivityModMin, const double resistivityMax,
+	const ResistivityBlockOverlay& resistivityBlockMod, std::ostream& ofsLog ){
+
+	ResistivityBlock* ptrResistivityBlockReference = new ResistivityBlock;
+	ptrResistivityBlockReference->copyResisitivityBlock(resistivityBlock);
+	ptrResistivityBlockReference->changeResistivityOfSelectedElements(elementsSelected, resistivityMod, resistivityModMin, resistivityMax);
+	const bool isVerified = compareResistivityBlocks(numElems, *ptrResistivityBlockReference, resistivityBlockMod, ofsLog);
+	delete ptrResistivityBlockReference;
+	return isVerified;
+
+}
+
+// Change resistivity of the selected elements by the reference implementation and compare the model with the output files
+bool Verifier::verifyOutputFiles( const bool isTetra, const int numElems, const int iterNum, const std::string& prefix,
+	const ResistivityBlock& resistivityBlock, const std::set<int>& elementsSelected,
+	const double resistivityMod, const double resistivityModMin, const double resistivityMax, std::ostream& ofsLog ){
+
+	ResistivityBlock* ptrResistivityBlockReference = new ResistivityBlock;
+	ptrResistivityBlockReference->copyResisitivityBlock(resistivityBlock);
+	ptrResistivityBlockReference->changeResistivityOfSelectedElements(elementsSelected, resistivityMod, resistivityModMin, resistivityMax);
+	const bool isVerified = compareOutputFiles(isTetra, numElems, iterNum, prefix, *ptrResistivityBlockReference, ofsLog);
+	delete ptrResistivityBlockReference;
+	return isVerified;
+
+}
+
+// Compare the output file of the resistivity block model with the reference model
+bool Verifier::compareResistivityBlockFile( const int numElems, const std::string& fileName,
+	const ResistivityBlock& resistivityBlockReference, std::ostream& ofsLog ){
+
+	std::ifstream ifs( fileName.c_str(), std::ios::in );
+	if( ifs.fail() ){
+		ofsLog << "Verification of the output file failed : " << fileName << " cannot be opened" << std::endl;
+		return false;
+	}
+
+	const int numBlocksRef = resistivityBlockReference.getNumResistivityBlockTotal();
+	int numElemsFile(-1);
+	int numBlocksFile(-1);
+	ifs >> numElemsFile >> numBlocksFile;
+	if( ifs.fail() || numElemsFile != numElems || numBlocksFile != numBlocksRef ){
+		ofsLog << "Verification of the output file failed : " << fileName << " has " << numElemsFile << " elements and " << numBlocksFile
+			<< " blocks while the reference has " << numElems << " elements and " << numBlocksRef << " blocks" << std::endl;
+		return false;
+	}
+
+	int numElementsMismatched(0);
+	for( int iElem = 0; iElem < numElems; ++iElem ){
+		int idum(-1);
+		int iBlk(-1);
+		ifs >> idum >> iBlk;
+		if( ifs.fail() ){
+			ofsLog << "Verification of the output file failed : " << fileName << " ends at element " << iElem << std::endl;
+			return false;
+		}
+		const int iBlkRef = resistivityBlockReference.getBlockFromElement(iElem);
+		if( idum != iElem || iBlk != iBlkRef ){
+			if( numElementsMismatched < m_maxNumMismatchesReported ){
+				ofsLog << "Mismatch : line of element " << iElem << " in " << fileName << " is \"" << idum << " " << iBlk
+					<< "\" while the element belongs to block " << iBlkRef << " in the reference" << std::endl;
+			}
+			++numElementsMismatched;
+		}
+	}
+
+	int numBlocksMismatched(0);
+	for( int iBlk = 0; iBlk < numBlocksRef; ++iBlk ){
+		int idum(-1);
+		ResistivityBlock::ResistivityBlockInformation info;
+		ifs >> idum >> info.resistivityValue >> info.resistivityValueMin >> info.resistivityValueMax >> info.weightingConstant >> info.type;
+		if( ifs.fail() ){
+			ofsLog << "Verification of the output file failed : " << fileName << " ends at block " << iBlk << std::endl;
+			return false;
+		}
+		const ResistivityBlock::ResistivityBlockInformation& infoRef = resistivityBlockReference.getResistivityBlockInformation(iBlk);
+		if( idum != iBlk ||
+			info.resistivityValue != getValueAsWritten( infoRef.resistivityValue ) ||
+			info.resistivityValueMin != getValueAsWritten( infoRef.resistivityValueMin ) ||
+			info.resistivityValueMax != getValueAsWritten( infoRef.resistivityValueMax ) ||
+			info.weightingConstant != getValueAsWritten( infoRef.weightingConstant ) ||
+			info.type != infoRef.type ){
+			if( numBlocksMismatched < m_maxNumMismatchesReported ){
+				ofsLog << "Mismatch : line of block " << iBlk << " in " << fileName << " has index " << idum << " and";
+				writeResistivityBlockInformation( info, ofsLog );
+				ofsLog << " while the block has";
+				writeResistivityBlockInformation( infoRef, ofsLog );
+				ofsLog << " in the reference" << std::endl;
+			}
+			++numBlocksMismatched;
+		}
+	}
+
+	std::string extra;
+	ifs >> extra;
+	const bool hasExtraData = !ifs.fail();
+	if( hasExtraData ){
+		ofsLog << "Mismatch : " << fileName << " has extra data after the last block" << std::endl;
+	}
+
+	if( numElementsMismatched > 0 || numBlocksMismatched > 0 || hasExtraData ){
+		ofsLog << "Verification of the output file failed : " << numElementsMismatched << " elements and "
+			<< numBlocksMismatched << " blocks are mismatched in " << fileName << std::endl;
+		return false;
+	}
+	return true;
+
+}
+
+// Compare the binary file of the resistivity values with the reference model
+bool Verifier::compareResistivityValueFile( const bool isTetra, const int numElems, const std::string& fileName,
+	const ResistivityBlock& resistivityBlockReference, std::ostream& ofsLog ){
+
+	std::ifstream ifs( fileName.c_str(), std::ios::in | std::ios::binary );
+	if( ifs.fail() ){
+		ofsLog << "Verification of the output file failed : " << fileName << " cannot be opened" << std::endl;
+		return false;
+	}
+
+	// Only the strings before the terminating null characters of the lines are compared
+	char title[80];
+	char part[80];
+	int numParts(0);
+	char elementType[80];
+	ifs.read( title, 80 );
+	ifs.read( part, 80 );
+	ifs.read( reinterpret_cast<char*>(&numParts), sizeof(int) );
+	ifs.read( elementType, 80 );
+	if( ifs.fail() || strncmp( title, "Resistivity[Ohm-m]", 80 ) != 0 || strncmp( part, "part", 80 ) != 0 || numParts != 1 ||
+		strncmp( elementType, isTetra ? "tetra4" : "hexa8", 80 ) != 0 ){
+		ofsLog << "Verification of the output file failed : header of " << fileName << " is wrong" << std::endl;
+		return false;
+	}
+
+	std::vector<float> values( numElems );
+	if( numElems > 0 ){
+		ifs.read( reinterpret_cast<char*>(&values[0]), static_cast<std::streamsize>( sizeof(float) ) * numElems );
+	}
+	if( ifs.fail() ){
+		ofsLog << "Verification of the output file failed : " << fileName << " has less than " << numElems << " values" << std::endl;
+		return false;
+	}
+	const bool hasExtraData = ( ifs.peek() != std::ifstream::traits_type::eof() );
+	if( hasExtraData ){
+		ofsLog << "Mismatch : " << fileName << " has extra data after the last value" << std::endl;
+	}
+
+	int numElementsMismatched(0);
+	for( int iElem = 0; iElem < numElems; ++iElem ){
+		const int iBlkRef = resistivityBlockReference.getBlockFromElement(iElem);
+		const float valueRef = static_cast<float>( resistivityBlockReference.getResistivityBlockInformation(iBlkRef).resistivityValue );
+		if( values[iElem] != valueRef ){
+			if( numElementsMismatched < m_maxNumMismatchesReported ){
+				ofsLog << "Mismatch : resistivity of element " << iElem << " in " << fileName << " is " << values[iElem]
+					<< " while it is " << valueRef << " in the reference" << std::endl;
+			}
+			++numElementsMismatched;
+		}
+	}
+
+	if( numElementsMismatched > 0 || hasExtraData ){
+		ofsLog << "Verification of the output file failed : " << numElementsMismatched << " elements are mismatched in " << fileName << std::endl;
+		return false;
+	}
+	return true;
+
+}
+
+// Get value written to the output file of the resistivity block model in the format %15e
+double Verifier::getValueAsWritten( const double value ){
+	char buf[64];
+	sprintf( buf, "%15e", value );
+	return atof(buf);
+}
+
+// Write information of a resistivity block
+void Verifier::writeResistivityBlockInformation( const ResistivityBlock::ResistivityBlockInformation& info, std::ostream& ofsLog ){
+
+	const std::streamsize precision = ofsLog.precision();
+	ofsLog << std::setprecision(17)
+		<< " ( resistivity " << info.resistivityValue
+		<< ", min " << info.resistivityValueMin
+		<< ", max " << info.resistivityValueMax
+		<< ", weighting " << info.weightingConstant
+		<< ", type " << info.type << " )" << std::setprecision(precision);
+
+}
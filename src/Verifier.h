@@ -0,0 +1,87 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#ifndef DBLDEF_VERIFIER
+#define DBLDEF_VERIFIER
+
+#include <iostream>
+#include <set>
+#include <string>
+#include "ResistivityBlock.h"
+#include "ResistivityBlockOverlay.h"
+
+// Class comparing the results of the optimized implementations with those of the serial reference implementations
+// [note] : Only the mismatches and the summary of a failed comparison are written to the stream.
+//          At most m_maxNumMismatchesReported mismatches of each kind are written.
+class Verifier{
+
+public:
+
+	// Compare the selected elements with those selected by the reference implementation
+	static bool compareSelectedElements( const std::set<int>& elementsReference, const std::set<int>& elementsSelected, std::ostream& ofsLog );
+
+	// Compare the modified resistivity block model with that modified by the reference implementation
+	static bool compareResistivityBlocks( const int numElems, const ResistivityBlock& resistivityBlockReference,
+		const ResistivityBlockOverlay& resistivityBlockMod, std::ostream& ofsLog );
+
+	// Compare the output files of the modified model with the model modified by the reference implementation
+	static bool compareOutputFiles( const bool isTetra, const int numElems, const int iterNum, const std::string& prefix,
+		const ResistivityBlock& resistivityBlockReference, std::ostream& ofsLog );
+
+	// Change resistivity of the selected elements by the reference implementation and compare the model with the modified model
+	// [note] : The reference model is copied from the base model and is changed in place
+	static bool verifyModification( const int numElems, const ResistivityBlock& resistivityBlock, const std::set<int>& elementsSelected,
+		const double resistivityMod, const double resistivityModMin, const double resistivityMax,
+		const ResistivityBlockOverlay& resistivityBlockMod, std::ostream& ofsLog );
+
+	// Change resistivity of the selected elements by the reference implementation and compare the model with the output files
+	// [note] : The reference model is copied from the base model and is changed in place
+	static bool verifyOutputFiles( const bool isTetra, const int numElems, const int iterNum, const std::string& prefix,
+		const ResistivityBlock& resistivityBlock, const std::set<int>& elementsSelected,
+		const double resistivityMod, const double resistivityModMin, const double resistivityMax, std::ostream& ofsLog );
+
+private:
+
+	// Constructer
+	Verifier();
+
+	// Maximum number of the mismatches of each kind written to the stream
+	static const int m_maxNumMismatchesReported = 10;
+
+	// Compare the output file of the resistivity block model with the reference model
+	static bool compareResistivityBlockFile( const int numElems, const std::string& fileName,
+		const ResistivityBlock& resistivityBlockReference, std::ostream& ofsLog );
+
+	// Compare the binary file of the resistivity values with the reference model
+	static bool compareResistivityValueFile( const bool isTetra, const int numElems, const std::string& fileName,
+		const ResistivityBlock& resistivityBlockReference, std::ostream& ofsLog );
+
+	// Get value written to the output file of the resistivity block model in the format %15e
+	static double getValueAsWritten( const double value );
+
+	// Write information of a resistivity block
+	static void writeResistivityBlockInformation( const ResistivityBlock::ResistivityBlockInformation& info, std::ostream& ofsLog );
+
+};
+
+#endif
@@ -0,0 +1,650 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <set>
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#ifdef _USE_OMP
+#include <omp.h>
+#endif
+
+#include "MeshData.h"
+#include "MeshDataTetraElement.h"
+#include "MeshDataNonConformingHexaElement.h"
+#include "ResistivityBlock.h"
+#include "ResistivityBlockOverlay.h"
+#include "Region.h"
+#include "CompositeRegion.h"
+#include "ElementSelector.h"
+#include "PerformanceReport.h"
+#include "Verifier.h"
+#include "Util.h"
+
+// Program of micro-benchmarks of the hot paths of the selection and the resistivity blocks
+// mesh.dat and resistivity_block_iter0.dat in the current directory are used ( e.g. made by makeSyntheticMesh ).
+// Usage : benchmark [-repeat n] [-filter string] [-verify]
+//   -repeat n      : Number of the measured runs of each benchmark, whose median and minimum are reported
+//   -filter string : Only the benchmarks whose names contain the string are run
+//   -verify        : Results of the benchmarks are verified against the serial reference implementations
+//                    and the program exits with status 1 if any of them is mismatched
+
+namespace{
+
+// Sink of the results of the measured operations, which keeps them from being optimized away
+volatile double g_sink = 0.0;
+
+// Case of micro-benchmark
+class BenchmarkCase{
+public:
+	virtual ~BenchmarkCase(){}
+	// Prepare data modified by the previous run, which is not measured
+	virtual void prepare(){}
+	// Run the measured operation and return number of the processed items
+	virtual long long run() = 0;
+	// Verify the result of the operation against the reference implementation
+	// [note] : Mismatches are written to the stream. Cases having no reference implementation are always verified.
+	virtual bool verify( std::ostream& /*ofsLog*/ ){
+		return true;
+	}
+};
+
+// Calculation of the centers of all the elements
+class ElementCenterCase : public BenchmarkCase{
+public:
+	ElementCenterCase( const MeshData* const ptrMeshData ):
+		m_ptrMeshData(ptrMeshData)
+	{}
+	virtual long long run(){
+		const int numElem = m_ptrMeshData->getNumElemTotal();
+		double sum(0.0);
+		for( int iElem = 0; iElem < numElem; ++iElem ){
+			const CommonParameters::locationXYZ center = m_ptrMeshData->getElementCenter(iElem);
+			sum += center.X + center.Y + center.Z;
+		}
+		g_sink = sum;
+		return numElem;
+	}
+private:
+	const MeshData* m_ptrMeshData;
+};
+
+// Look-up of the resistivity blocks of the elements in the specified order
+class BlockFromElementCase : public BenchmarkCase{
+public:
+	BlockFromElementCase( const ResistivityBlock* const ptrResistivityBlock, const std::vector<int>& elements ):
+		m_ptrResistivityBlock(ptrResistivityBlock),
+		m_elements(elements)
+	{}
+	virtual long long run(){
+		long long sum(0);
+		for( std::vector<int>::const_iterator itr = m_elements.begin(); itr != m_elements.end(); ++itr ){
+			sum += m_ptrResistivityBlock->getBlockFromElement(*itr);
+		}
+		g_sink = static_cast<double>(sum);
+		return static_cast<long long>( m_elements.size() );
+	}
+private:
+	const ResistivityBlock* m_ptrResistivityBlock;
+	const std::vector<int>& m_elements;
+};
+
+// Check of the fixed resistivity blocks of the elements
+class FixedResistivityCase : public BenchmarkCase{
+public:
+	FixedResistivityCase( const ResistivityBlock* const ptrResistivityBlock, const std::vector<int>& blocks ):
+		m_ptrResistivityBlock(ptrResistivityBlock),
+		m_blocks(blocks)
+	{}
+	virtual long long run(){
+		long long count(0);
+		for( std::vector<int>::const_iterator itr = m_blocks.begin(); itr != m_blocks.end(); ++itr ){
+			if( m_ptrResistivityBlock->isFixedResistivityValue(*itr) ){
+				++count;
+			}
+		}
+		g_sink = static_cast<double>(count);
+		return static_cast<long long>( m_blocks.size() );
+	}
+private:
+	const ResistivityBlock* m_ptrResistivityBlock;
+	const std::vector<int>& m_blocks;
+};
+
+// Integration of the positive parts of bilinear functions over the unit square
+// [note] : The corner values include degenerate configurations in which the zero lines pass through corners or
+//          the roots of both the edges coincide
+class BilinearPositivePartCase : public BenchmarkCase{
+public:
+	BilinearPositivePartCase(){
+		const double corners[][4] = {
+			{ -1.0, 1.0, 1.0, -1.0 },
+			{ 1.0, -1.0, -1.0, 1.0 },
+			{ -1.0e-9, 1.0e-9, 1.0e-9, -1.0e-9 },
+			{ 1.0, -1.0, 0.0, 0.0 },
+			{ 0.0, 0.0, 1.0, -1.0 },
+			{ 0.0, 1.0, 0.0, -1.0 },
+			{ 1.0, -1.0, 1.0, -1.0 },
+			{ 1.0, -1.0, 1.0 + 1.0e-14, -1.0 },
+			{ 2.0, -1.0, -1.0, 2.0 },
+			{ 1.0, -2.0, 3.0, -0.5 },
+			{ -1.0, 3.0, 2.0, -2.0 },
+		};
+		const int numConfigurations = sizeof(corners) / sizeof(corners[0]);
+		for( int i = 0; i < numConfigurations; ++i ){
+			m_corners.push_back( std::vector<double>( corners[i], corners[i] + 4 ) );
+		}
+	}
+	virtual long long run(){
+		const int numRepeats = 10000;
+		double sum(0.0);
+		for( int iRepeat = 0; iRepeat < numRepeats; ++iRepeat ){
+			for( std::vector< std::vector<double> >::const_iterator itr = m_corners.begin(); itr != m_corners.end(); ++itr ){
+				sum += calcIntegralOfPositivePartOfBilinearFunction( (*itr)[0], (*itr)[1], (*itr)[2], (*itr)[3] );
+			}
+		}
+		g_sink = sum;
+		return static_cast<long long>( numRepeats ) * static_cast<long long>( m_corners.size() );
+	}
+	virtual bool verify( std::ostream& ofsLog ){
+		// The reference is the midpoint rule on a fine grid
+		const int numDivisions = 1000;
+		bool isVerified(true);
+		for( std::vector< std::vector<double> >::const_iterator itr = m_corners.begin(); itr != m_corners.end(); ++itr ){
+			const double f00 = (*itr)[0];
+			const double f10 = (*itr)[1];
+			const double f01 = (*itr)[2];
+			const double f11 = (*itr)[3];
+			double reference(0.0);
+			for( int j = 0; j < numDivisions; ++j ){
+				const double v = ( j + 0.5 ) / numDivisions;
+				for( int i = 0; i < numDivisions; ++i ){
+					const double u = ( i + 0.5 ) / numDivisions;
+					const double f = f00 * ( 1.0 - u ) * ( 1.0 - v ) + f10 * u * ( 1.0 - v ) + f01 * ( 1.0 - u ) * v + f11 * u * v;
+					reference += std::max( f, 0.0 );
+				}
+			}
+			reference /= static_cast<double>(numDivisions) * static_cast<double>(numDivisions);
+			const double val = calcIntegralOfPositivePartOfBilinearFunction( f00, f10, f01, f11 );
+			const double scale = std::max( std::max( fabs(f00), fabs(f10) ), std::max( fabs(f01), fabs(f11) ) );
+			if( !( fabs( val - reference ) <= 1.0e-5 * scale ) ){
+				ofsLog << "Mismatch : integral of positive part of bilinear function with corner values "
+					<< f00 << " " << f10 << " " << f01 << " " << f11 << " is " << val << " while it is " << reference << " by sampling" << std::endl;
+				isVerified = false;
+			}
+		}
+		return isVerified;
+	}
+private:
+	std::vector< std::vector<double> > m_corners;
+};
+
+// Test of the points one by one
+class InRegionPointCase : public BenchmarkCase{
+public:
+	InRegionPointCase( const Region* const ptrRegion, const std::vector<CommonParameters::locationXYZ>& points ):
+		m_ptrRegion(ptrRegion),
+		m_points(points)
+	{}
+	virtual long long run(){
+		long long count(0);
+		for( std::vector<CommonParameters::locationXYZ>::const_iterator itr = m_points.begin(); itr != m_points.end(); ++itr ){
+			if( m_ptrRegion->inRegion(*itr) ){
+				++count;
+			}
+		}
+		g_sink = static_cast<double>(count);
+		return static_cast<long long>( m_points.size() );
+	}
+private:
+	const Region* m_ptrRegion;
+	const std::vector<CommonParameters::locationXYZ>& m_points;
+};
+
+// Test of the points as a batch
+class InRegionBatchCase : public BenchmarkCase{
+public:
+	InRegionBatchCase( const Region* const ptrRegion, const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& z ):
+		m_ptrRegion(ptrRegion),
+		m_x(x),
+		m_y(y),
+		m_z(z),
+		m_flags( x.size(), 0 )
+	{}
+	virtual long long run(){
+		const int numPoints = static_cast<int>( m_x.size() );
+		m_ptrRegion->inRegion( numPoints, &m_x[0], &m_y[0], &m_z[0], &m_flags[0] );
+		long long count(0);
+		for( int i = 0; i < numPoints; ++i ){
+			count += m_flags[i];
+		}
+		g_sink = static_cast<double>(count);
+		return numPoints;
+	}
+	virtual bool verify( std::ostream& ofsLog ){
+		// The points are tested one by one in the reference
+		std::set<int> pointsReference;
+		std::set<int> points;
+		const int numPoints = static_cast<int>( m_x.size() );
+		for( int i = 0; i < numPoints; ++i ){
+			const CommonParameters::locationXYZ point = { m_x[i], m_y[i], m_z[i] };
+			if( m_ptrRegion->inRegion(point) ){
+				pointsReference.insert( pointsReference.end(), i );
+			}
+			if( m_flags[i] != 0 ){
+				points.insert( points.end(), i );
+			}
+		}
+		return Verifier::compareSelectedElements( pointsReference, points, ofsLog );
+	}
+private:
+	const Region* m_ptrRegion;
+	const std::vector<double>& m_x;
+	const std::vector<double>& m_y;
+	const std::vector<double>& m_z;
+	std::vector<unsigned char> m_flags;
+};
+
+// Selection of the elements in a region
+class SelectElementsCase : public BenchmarkCase{
+public:
+	SelectElementsCase( const ElementSelector* const ptrSelector, const ResistivityBlock* const ptrResistivityBlock, const Region* const ptrRegion,
+		const ElementSelector::SelectionParameters& params, const ElementSelector::Eligibility& eligibility, const int numElem ):
+		m_ptrSelector(ptrSelector),
+		m_ptrResistivityBlock(ptrResistivityBlock),
+		m_ptrRegion(ptrRegion),
+		m_params(params),
+		m_eligibility(eligibility),
+		m_numElem(numElem)
+	{}
+	virtual long long run(){
+		std::set<int> elementsSelected;
+		m_ptrSelector->selectElements( *m_ptrResistivityBlock, *m_ptrRegion, m_params, m_eligibility, elementsSelected );
+		g_sink = static_cast<double>( elementsSelected.size() );
+		return m_numElem;
+	}
+	virtual bool verify( std::ostream& ofsLog ){
+		std::set<int> elementsReference;
+		std::set<int> elementsSelected;
+		m_ptrSelector->selectElementsReference( *m_ptrResistivityBlock, *m_ptrRegion, m_params, elementsReference );
+		m_ptrSelector->selectElements( *m_ptrResistivityBlock, *m_ptrRegion, m_params, m_eligibility, elementsSelected );
+		return Verifier::compareSelectedElements( elementsReference, elementsSelected, ofsLog );
+	}
+private:
+	const ElementSelector* m_ptrSelector;
+	const ResistivityBlock* m_ptrResistivityBlock;
+	const Region* m_ptrRegion;
+	const ElementSelector::SelectionParameters& m_params;
+	const ElementSelector::Eligibility& m_eligibility;
+	int m_numElem;
+};
+
+// Change of the resistivity blocks of the selected elements in place
+// [note] : The resistivity block model is input again before each run
+class ChangeResistivityCase : public BenchmarkCase{
+public:
+	ChangeResistivityCase( const std::set<int>& elementsSelected ):
+		m_ptrResistivityBlock(NULL),
+		m_elementsSelected(elementsSelected)
+	{}
+	virtual ~ChangeResistivityCase(){
+		delete m_ptrResistivityBlock;
+	}
+	virtual void prepare(){
+		delete m_ptrResistivityBlock;
+		m_ptrResistivityBlock = new ResistivityBlock;
+		m_ptrResistivityBlock->inputResisitivityBlock(0);
+	}
+	virtual long long run(){
+		m_ptrResistivityBlock->changeResistivityOfSelectedElements( m_elementsSelected, 1.0, 0.1, 10.0 );
+		g_sink = static_cast<double>( m_ptrResistivityBlock->getNumResistivityBlockTotal() );
+		return static_cast<long long>( m_elementsSelected.size() );
+	}
+private:
+	ResistivityBlock* m_ptrResistivityBlock;
+	const std::set<int>& m_elementsSelected;
+};
+
+// Change of the resistivity blocks of the selected elements in an overlay of the base model
+class ChangeResistivityOverlayCase : public BenchmarkCase{
+public:
+	ChangeResistivityOverlayCase( const ResistivityBlock* const ptrResistivityBlock, const std::set<int>& elementsSelected, const int numElem ):
+		m_ptrResistivityBlock(ptrResistivityBlock),
+		m_elementsSelected(elementsSelected),
+		m_numElem(numElem)
+	{}
+	virtual long long run(){
+		ResistivityBlockOverlay overlay(m_ptrResistivityBlock);
+		overlay.changeResistivityOfSelectedElements( m_elementsSelected, 1.0, 0.1, 10.0 );
+		g_sink = static_cast<double>( overlay.getNumResistivityBlockTotal() );
+		return static_cast<long long>( m_elementsSelected.size() );
+	}
+	virtual bool verify( std::ostream& ofsLog ){
+		// The reference model is changed in place by ResistivityBlock
+		ResistivityBlockOverlay overlay(m_ptrResistivityBlock);
+		overlay.changeResistivityOfSelectedElements( m_elementsSelected, 1.0, 0.1, 10.0 );
+		return Verifier::verifyModification( m_numElem, *m_ptrResistivityBlock, m_elementsSelected, 1.0, 0.1, 10.0, overlay, ofsLog );
+	}
+private:
+	const ResistivityBlock* m_ptrResistivityBlock;
+	const std::set<int>& m_elementsSelected;
+	int m_numElem;
+};
+
+int g_numRepeats = 5;
+std::string g_filter = "";
+bool g_verify = false;
+int g_numFailures = 0;
+
+// Run a benchmark and print its result
+// The first run is a warm-up and is not measured
+void runBenchmark( const std::string& name, BenchmarkCase& benchmarkCase, const double selectivity ){
+
+	if( !g_filter.empty() && name.find(g_filter) == std::string::npos ){
+		return;
+	}
+
+	benchmarkCase.prepare();
+	long long numItems = benchmarkCase.run();
+	std::vector<double> times;
+	for( int iRepeat = 0; iRepeat < g_numRepeats; ++iRepeat ){
+		benchmarkCase.prepare();
+		const double start = PerformanceReport::getWallTime();
+		numItems = benchmarkCase.run();
+		times.push_back( PerformanceReport::getWallTime() - start );
+	}
+	std::sort( times.begin(), times.end() );
+	const double median = times.size() % 2 == 1 ? times[ times.size() / 2 ] : 0.5 * ( times[ times.size() / 2 - 1 ] + times[ times.size() / 2 ] );
+	const double items = static_cast<double>( std::max( numItems, 1LL ) );
+	std::string verification = "";
+	if( g_verify ){
+		// Mismatches are written before the result line of the benchmark
+		if( benchmarkCase.verify( std::cout ) ){
+			verification = " verified";
+		}else{
+			verification = " MISMATCH";
+			++g_numFailures;
+		}
+	}
+
+	if( selectivity >= 0.0 ){
+		printf( "%-72s %12lld %9.4f %14.3f %14.3f %14.4e%s\n", name.c_str(), numItems, selectivity * 100.0,
+			median / items * 1.0e9, times.front() / items * 1.0e9, items / median, verification.c_str() );
+	}else{
+		printf( "%-72s %12lld %9s %14.3f %14.3f %14.4e%s\n", name.c_str(), numItems, "-",
+			median / items * 1.0e9, times.front() / items * 1.0e9, items / median, verification.c_str() );
+	}
+	fflush(stdout);
+
+}
+
+// Calculate fraction of the points located in the region
+double calcFractionInRegion( const Region& region, const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& z ){
+
+	const int numPoints = static_cast<int>( x.size() );
+	std::vector<unsigned char> flags( numPoints, 0 );
+	region.inRegion( numPoints, &x[0], &y[0], &z[0], &flags[0] );
+	long long count(0);
+	for( int i = 0; i < numPoints; ++i ){
+		count += flags[i];
+	}
+	return static_cast<double>(count) / static_cast<double>(numPoints);
+
+}
+
+// Create region of the specified type scaled by the factor
+// The lengths of the region are the products of the factor and the extents of the element centers
+Region* createRegion( const std::string& type, const CommonParameters::locationXYZ& center, const CommonParameters::locationXYZ& extent, const double factor ){
+
+	if( type.compare("composite") == 0 ){
+		// ( Ellipsoid | shifted cuboid ) - small ellipsoid
+		std::vector<Region> primitives(3);
+		CommonParameters::locationXYZ shifted = center;
+		shifted.X += 0.25 * factor * extent.X;
+		primitives[0].setParameters( Region::ELLIPSOID, center, factor * extent.X, factor * extent.Y, factor * extent.Z, 0.0 );
+		primitives[1].setParameters( Region::CUBOID, shifted, 0.8 * factor * extent.X, 0.8 * factor * extent.Y, 0.8 * factor * extent.Z, 0.0 );
+		primitives[2].setParameters( Region::ELLIPSOID, center, 0.3 * factor * extent.X, 0.3 * factor * extent.Y, 0.3 * factor * extent.Z, 0.0 );
+		CompositeRegion* ptrRegion = new CompositeRegion;
+		ptrRegion->setComponents( primitives, "(0|1)-2" );
+		return ptrRegion;
+	}
+
+	Region* ptrRegion = new Region;
+	if( type.compare("ellipsoid") == 0 ){
+		ptrRegion->setParameters( Region::ELLIPSOID, center, factor * extent.X, factor * extent.Y, factor * extent.Z, 0.0 );
+	}else if( type.compare("cuboid") == 0 ){
+		ptrRegion->setParameters( Region::CUBOID, center, factor * extent.X, factor * extent.Y, factor * extent.Z, 0.0 );
+	}else if( type.compare("rotated_cuboid") == 0 ){
+		ptrRegion->setParameters( Region::CUBOID, center, factor * extent.X, factor * extent.Y, factor * extent.Z, 30.0 * CommonParameters::deg2rad );
+	}else{
+		ptrRegion->setParameters( Region::CYLINDROID, center, factor * extent.X, factor * extent.Y, factor * extent.Z, 0.0 );
+	}
+	return ptrRegion;
+
+}
+
+// Create region of the specified type containing the specified fraction of the element centers
+// The scale factor is determined by bisection
+Region* createRegionOfSelectivity( const std::string& type, const CommonParameters::locationXYZ& center, const CommonParameters::locationXYZ& extent,
+	const double selectivity, const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& z ){
+
+	double lower(0.0);
+	double upper(1.0);
+	for( int i = 0; i < 16; ++i ){
+		Region* ptrRegion = createRegion( type, center, extent, upper );
+		const double fraction = calcFractionInRegion( *ptrRegion, x, y, z );
+		delete ptrRegion;
+		if( fraction >= selectivity ){
+			break;
+		}
+		upper *= 2.0;
+	}
+	for( int i = 0; i < 40; ++i ){
+		const double middle = 0.5 * ( lower + upper );
+		Region* ptrRegion = createRegion( type, center, extent, middle );
+		const double fraction = calcFractionInRegion( *ptrRegion, x, y, z );
+		delete ptrRegion;
+		if( fraction < selectivity ){
+			lower = middle;
+		}else{
+			upper = middle;
+		}
+	}
+	return createRegion( type, center, extent, upper );
+
+}
+
+}
+
+int main( int argc, char* argv[] ){
+
+	for( int i = 1; i < argc; ++i ){
+		const std::string option = argv[i];
+		if( option.compare("-repeat") == 0 && i + 1 < argc ){
+			g_numRepeats = std::max( atoi( argv[++i] ), 1 );
+		}else if( option.compare("-filter") == 0 && i + 1 < argc ){
+			g_filter = argv[++i];
+		}else if( option.compare("-verify") == 0 ){
+			g_verify = true;
+		}else{
+			std::cerr << "Usage : benchmark [-repeat n] [-filter string] [-verify]" << std::endl;
+			exit(1);
+		}
+	}
+
+	std::ifstream inFile( "mesh.dat", std::ios::in );
+	if( inFile.fail() ){
+		std::cerr << "File open error : mesh.dat !!" << std::endl;
+		exit(1);
+	}
+	std::string meshType;
+	inFile >> meshType;
+	inFile.close();
+	MeshData* ptrMeshData = NULL;
+	if( meshType.substr(0,5).compare("TETRA") == 0 ){
+		ptrMeshData = new MeshDataTetraElement;
+	}else if( meshType.substr(0,5).compare("DHEXA") == 0 ){
+		ptrMeshData = new MeshDataNonConformingHexaElement;
+	}else{
+		std::cerr << "Unsupported mesh type: " << meshType << std::endl;
+		exit(1);
+	}
+	ptrMeshData->inputMeshData();
+	ptrMeshData->reorderBySpaceFillingCurve();
+	ResistivityBlock resistivityBlock;
+	resistivityBlock.inputResisitivityBlock(0);
+	resistivityBlock.calcBoundingBoxesOfBlocks(ptrMeshData);
+	const ElementSelector selector(ptrMeshData);
+
+	const int numElem = ptrMeshData->getNumElemTotal();
+	int numThreads(1);
+#ifdef _USE_OMP
+	numThreads = omp_get_max_threads();
+#endif
+	std::cout << "Mesh type: " << meshType << std::endl;
+	std::cout << "Total number of elements : " << numElem << std::endl;
+	std::cout << "Total number of resistivity blocks : " << resistivityBlock.getNumResistivityBlockTotal() << std::endl;
+	std::cout << "Number of threads : " << numThreads << std::endl;
+	std::cout << "Number of measured runs : " << g_numRepeats << std::endl;
+	printf( "%-72s %12s %9s %14s %14s %14s\n", "Benchmark", "Items", "Select[%]", "Median[ns/it]", "Min[ns/it]", "Items/s" );
+
+	// Element centers and their extent
+	std::vector<CommonParameters::locationXYZ> centers( numElem );
+	std::vector<double> x( numElem );
+	std::vector<double> y( numElem );
+	std::vector<double> z( numElem );
+	CommonParameters::locationXYZ minCoord = { 1.0e+99, 1.0e+99, 1.0e+99 };
+	CommonParameters::locationXYZ maxCoord = { -1.0e+99, -1.0e+99, -1.0e+99 };
+	for( int iElem = 0; iElem < numElem; ++iElem ){
+		centers[iElem] = ptrMeshData->getElementCenter(iElem);
+		x[iElem] = centers[iElem].X;
+		y[iElem] = centers[iElem].Y;
+		z[iElem] = centers[iElem].Z;
+		minCoord.X = std::min( minCoord.X, x[iElem] );
+		minCoord.Y = std::min( minCoord.Y, y[iElem] );
+		minCoord.Z = std::min( minCoord.Z, z[iElem] );
+		maxCoord.X = std::max( maxCoord.X, x[iElem] );
+		maxCoord.Y = std::max( maxCoord.Y, y[iElem] );
+		maxCoord.Z = std::max( maxCoord.Z, z[iElem] );
+	}
+	const CommonParameters::locationXYZ center = { 0.5 * ( minCoord.X + maxCoord.X ), 0.5 * ( minCoord.Y + maxCoord.Y ), 0.5 * ( minCoord.Z + maxCoord.Z ) };
+	const CommonParameters::locationXYZ extent = { maxCoord.X - minCoord.X, maxCoord.Y - minCoord.Y, maxCoord.Z - minCoord.Z };
+
+	// Elements in sequential and shuffled orders and their blocks
+	std::vector<int> elementsSequential( numElem );
+	std::vector<int> blocksOfElements( numElem );
+	for( int iElem = 0; iElem < numElem; ++iElem ){
+		elementsSequential[iElem] = iElem;
+		blocksOfElements[iElem] = resistivityBlock.getBlockFromElement(iElem);
+	}
+	std::vector<int> elementsShuffled( elementsSequential );
+	unsigned int state(12345);
+	for( int i = numElem - 1; i > 0; --i ){
+		state = state * 1664525u + 1013904223u;
+		std::swap( elementsShuffled[i], elementsShuffled[ state % static_cast<unsigned int>( i + 1 ) ] );
+	}
+
+	{
+		ElementCenterCase benchmarkCase(ptrMeshData);
+		runBenchmark( "MeshData::getElementCenter", benchmarkCase, -1.0 );
+	}
+	{
+		BlockFromElementCase benchmarkCase(&resistivityBlock, elementsSequential);
+		runBenchmark( "ResistivityBlock::getBlockFromElement/sequential", benchmarkCase, -1.0 );
+	}
+	{
+		BlockFromElementCase benchmarkCase(&resistivityBlock, elementsShuffled);
+		runBenchmark( "ResistivityBlock::getBlockFromElement/shuffled", benchmarkCase, -1.0 );
+	}
+	{
+		FixedResistivityCase benchmarkCase(&resistivityBlock, blocksOfElements);
+		runBenchmark( "ResistivityBlock::isFixedResistivityValue", benchmarkCase, -1.0 );
+	}
+	{
+		BilinearPositivePartCase benchmarkCase;
+		runBenchmark( "calcIntegralOfPositivePartOfBilinearFunction", benchmarkCase, -1.0 );
+	}
+
+	ElementSelector::SelectionParameters params;
+	params.selectionMode = ElementSelector::CENTER_OF_ELEMENT;
+	params.numGaussPoints = 2;
+	params.thresholdVolumeFraction = 0.5;
+	params.resistivityMin = 0.0;
+	params.resistivityMax = 1.0e+30;
+	ElementSelector::Eligibility eligibility;
+	selector.calcEligibility( resistivityBlock, params.resistivityMin, params.resistivityMax, eligibility );
+
+	const int numTypes = 5;
+	const std::string types[numTypes] = { "ellipsoid", "cuboid", "rotated_cuboid", "cylindroid", "composite" };
+	const int numSelectivities = 5;
+	const double selectivities[numSelectivities] = { 0.0001, 0.001, 0.01, 0.1, 0.5 };
+	const std::string selectivityNames[numSelectivities] = { "0.01%", "0.1%", "1%", "10%", "50%" };
+	for( int iType = 0; iType < numTypes; ++iType ){
+		for( int iSel = 0; iSel < numSelectivities; ++iSel ){
+			const std::string suffix = "/" + types[iType] + "/" + selectivityNames[iSel];
+			Region* ptrRegion = createRegionOfSelectivity( types[iType], center, extent, selectivities[iSel], x, y, z );
+			const double selectivity = calcFractionInRegion( *ptrRegion, x, y, z );
+			{
+				InRegionPointCase benchmarkCase(ptrRegion, centers);
+				runBenchmark( "Region::inRegion/point" + suffix, benchmarkCase, selectivity );
+			}
+			{
+				InRegionBatchCase benchmarkCase(ptrRegion, x, y, z);
+				runBenchmark( "Region::inRegion/batch" + suffix, benchmarkCase, selectivity );
+			}
+			{
+				SelectElementsCase benchmarkCase(&selector, &resistivityBlock, ptrRegion, params, eligibility, numElem);
+				runBenchmark( "ElementSelector::selectElements" + suffix, benchmarkCase, selectivity );
+			}
+			if( iType == 0 ){
+				// Changes of the resistivity blocks depend only on the selected elements
+				std::set<int> elementsSelected;
+				selector.selectElements( resistivityBlock, *ptrRegion, params, eligibility, elementsSelected );
+				{
+					ChangeResistivityCase benchmarkCase(elementsSelected);
+					runBenchmark( "ResistivityBlock::changeResistivityOfSelectedElements" + suffix, benchmarkCase, selectivity );
+				}
+				{
+					ChangeResistivityOverlayCase benchmarkCase(&resistivityBlock, elementsSelected, numElem);
+					runBenchmark( "ResistivityBlockOverlay::changeResistivityOfSelectedElements" + suffix, benchmarkCase, selectivity );
+				}
+			}
+			delete ptrRegion;
+		}
+	}
+
+	delete ptrMeshData;
+
+	if( g_numFailures > 0 ){
+		std::cerr << "Verification against the reference implementation failed for " << g_numFailures << " benchmarks !!" << std::endl;
+		return 1;
+	}
+	return 0;
+
+}
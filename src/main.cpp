@@ -34,78 +34,287 @@
 #include <algorithm>
 #include <stdio.h>
 #include <string.h>
+#ifdef _USE_OMP
+#include <omp.h>
+#endif
 
 #include "MeshData.h"
 #include "MeshDataTetraElement.h"
 #include "MeshDataNonConformingHexaElement.h"
 #include "ResistivityBlock.h"
+#include "Region.h"
+#include "ElementSelector.h"
+#include "Scenario.h"
+#include "Checkerboard.h"
+#include "MultiRegion.h"
+#include "Server.h"
+#include "SharedMeshCache.h"
+#include "SelectionCache.h"
+#include "PerformanceReport.h"
+#include "Tracer.h"
+#include "ProgressReporter.h"
 
-enum RegionType{
-	ELLIPSOID = 0,
-	CUBOID,
-	CYLINDROID,
-};
-
-struct Length{
-	double xLength;
-	double yLength;
-	double zLength;
-};
-
-CommonParameters::locationXYZ m_center = { 0.0, 0.0, 0.0 };
-double m_angle;
 int m_numIteration = 0;
-int m_regionType = ELLIPSOID;
-double m_minResistivityForSelecting = 0.1;
-double m_maxResistivityForSelecting = 1.0e4;
-double m_modifiedResistivity = -1.0;
-double m_modifiedMinResistivity = 0.1;
-double m_modifiedMaxResistivity = 1.0e4;
-Length m_length = { 0.0, 0.0, 0.0 };
-ResistivityBlock m_resistivityBlock;
+int m_numScenarios = 0;
+Scenario* m_scenarios = NULL;
+Checkerboard* m_checkerboard = NULL;
+MultiRegion* m_multiRegion = NULL;
+int m_numScenarioThreads = 0;
+int m_numThreadsPerScenario = 0;
+std::string m_socketPath = "";
+std::string m_sharedMeshName = "";
+std::vector<int> m_iterations;
+ResistivityBlock* m_resistivityBlocks = NULL;
+std::string m_cacheDirectory = "";
+SelectionCache m_selectionCache;
+std::vector<std::string> m_cacheKeys;
+std::vector< std::set<int> > m_cachedSelections;
+std::vector<unsigned char> m_isCached;
+std::string m_reportFile = "";
+std::string m_traceFile = "";
+bool m_useHardwareCounters = false;
+bool m_verify = false;
+int m_numTasksFailedVerification = 0;
 
 void run( const std::string& paramFile );
 void readParameterFile( const std::string& paramFile );
-void selectElements( const MeshData* const MeshData, std::set<int>& elementsSelected );
-void selectResistivityBlocks();
-bool inRegion( const CommonParameters::locationXYZ& coord );
+void parseIterations( const std::string& iterations );
+bool lookUpSelectionCache( int& meshType, int& numElemTotal );
+void addMemoryUsageToReport( const MeshData* const ptrMeshData, const ElementSelector* const ptrSelector );
+void executeScenarios( const bool isTetra, const int numElemTotal, const MeshData* const ptrMeshData, const ElementSelector* const ptrSelector );
 
 int main( int argc, char* argv[] ){
 	if( argc < 2 ){
 		std::cerr << "You must specify parameter file  !!" << std::endl;
 		exit(1);
 	}
+	for( int i = 2; i < argc; ++i ){
+		const std::string option = argv[i];
+		if( option.compare("-threads") == 0 ){
+			// Number of scenarios executed concurrently and number of threads used in each scenario
+			// [note] : By default ( 0 ), as many scenarios as the available threads are executed concurrently
+			if( i + 2 >= argc ){
+				std::cerr << "Option -threads requires two arguments !!" << std::endl;
+				exit(1);
+			}
+			m_numScenarioThreads = atoi( argv[++i] );
+			m_numThreadsPerScenario = atoi( argv[++i] );
+			if( m_numScenarioThreads < 0 ){
+				std::cerr << "Number of scenarios executed concurrently must be non-negative ( 0 : automatic ) !!" << std::endl;
+				exit(1);
+			}
+		}else if( option.compare("-server") == 0 ){
+			// Path of the Unix domain socket of the server mode
+			if( i + 1 >= argc ){
+				std::cerr << "Option -server requires path of the socket !!" << std::endl;
+				exit(1);
+			}
+			m_socketPath = argv[++i];
+		}else if( option.compare("-shared_mesh") == 0 ){
+			// Name of the POSIX shared memory in which the mesh data are shared among processes
+			if( i + 1 >= argc ){
+				std::cerr << "Option -shared_mesh requires name of the shared memory !!" << std::endl;
+				exit(1);
+			}
+			m_sharedMeshName = argv[++i];
+			if( m_sharedMeshName[0] != '/' ){
+				m_sharedMeshName = "/" + m_sharedMeshName;
+			}
+		}else if( option.compare("-iter") == 0 ){
+			// List of iteration numbers such as 3,5,7-9
+			if( i + 1 >= argc ){
+				std::cerr << "Option -iter requires list of iteration numbers !!" << std::endl;
+				exit(1);
+			}
+			parseIterations( argv[++i] );
+		}else if( option.compare("-cache") == 0 ){
+			// Directory of the cache of the selected elements
+			if( i + 1 >= argc ){
+				std::cerr << "Option -cache requires directory of the cache !!" << std::endl;
+				exit(1);
+			}
+			m_cacheDirectory = argv[++i];
+		}else if( option.compare("-report") == 0 ){
+			// File to which the report of elapsed times and counters is written in JSON format
+			if( i + 1 >= argc ){
+				std::cerr << "Option -report requires name of the file !!" << std::endl;
+				exit(1);
+			}
+			m_reportFile = argv[++i];
+		}else if( option.compare("-trace") == 0 ){
+			// File to which the timeline of the phases and the tasks of the threads is written in Chrome trace format
+			if( i + 1 >= argc ){
+				std::cerr << "Option -trace requires name of the file !!" << std::endl;
+				exit(1);
+			}
+			m_traceFile = argv[++i];
+		}else if( option.compare("-progress") == 0 ){
+			// Interval in second of the reports of the progress of reading the input files
+			if( i + 1 >= argc ){
+				std::cerr << "Option -progress requires interval of the reports !!" << std::endl;
+				exit(1);
+			}
+			const double interval = atof( argv[++i] );
+			if( interval <= 0.0 ){
+				std::cerr << "Interval of the progress reports must be positive !!" << std::endl;
+				exit(1);
+			}
+			ProgressReporter::enable(interval);
+		}else if( option.compare("-hwcounters") == 0 ){
+			// Hardware performance counters of the phases are included in the report
+			m_useHardwareCounters = true;
+		}else if( option.compare("-verify") == 0 ){
+			// Results of the scenarios are verified against the serial reference implementations
+			// [note] : Volume fractions are calculated by the same function in the reference implementation
+			m_verify = true;
+		}else{
+			std::cerr << "Unknown option : " << option << std::endl;
+			exit(1);
+		}
+	}
+	if( m_useHardwareCounters ){
+		if( m_reportFile.empty() ){
+			std::cerr << "Option -hwcounters requires option -report !!" << std::endl;
+			exit(1);
+		}
+		if( !PerformanceReport::enableHardwareCounters() ){
+			std::cout << "Hardware performance counters are not available and are not reported" << std::endl;
+		}
+	}
+	if( !m_traceFile.empty() ){
+		Tracer::enable();
+	}
 	run( argv[1] );
 	return 0;
 }
 
 void run( const std::string& paramFile ){
 	readParameterFile(paramFile);
-	std::ifstream inFile( "mesh.dat", std::ios::in );
-	if( inFile.fail() )
-	{
-		std::cerr << "File open error : mesh.dat !!" << std::endl;
-		exit(1);
+	if( m_iterations.empty() ){
+		m_iterations.push_back(m_numIteration);
+	}
+	const int numIterations = static_cast<int>( m_iterations.size() );
+	if( m_verify && ( m_scenarios == NULL || !m_socketPath.empty() ) ){
+		std::cout << "Verification is performed only for scenarios" << std::endl;
 	}
-	std::string meshType;
-	inFile >> meshType;
-	std::cout << "Mesh type: " << meshType << std::endl;
+
+	// Mesh data are not required if the selections of all the scenarios are found in the cache
+	bool isMeshRequired(true);
+	int typeOfMesh(MeshData::TETRA);
+	int numElemTotal(0);
+	if( !m_cacheDirectory.empty() ){
+		if( m_scenarios != NULL && m_socketPath.empty() ){
+			// Mesh data are always required for the verification because the selections are verified as well
+			isMeshRequired = !lookUpSelectionCache(typeOfMesh, numElemTotal) || m_verify;
+		}else{
+			std::cout << "Cache of the selected elements is used only for scenarios" << std::endl;
+		}
+	}
+
 	MeshData* m_ptrMeshData = NULL; 
-	if( meshType.substr(0,5).compare("TETRA") == 0 ){
-		m_ptrMeshData = new MeshDataTetraElement;
-	}else if( meshType.substr(0,5).compare("DHEXA") == 0 ){
-		m_ptrMeshData = new MeshDataNonConformingHexaElement;
+	SharedMeshCache sharedMeshCache;
+	bool isAttached(false);
+	if( !isMeshRequired ){
+		std::cout << "Mesh data are not input because all the selections are found in the cache" << std::endl;
+	}else if( !m_sharedMeshName.empty() && sharedMeshCache.attach(m_sharedMeshName, "mesh.dat") ){
+		// Mesh data are not input but attached from the shared memory
+		if( sharedMeshCache.getMeshType() == MeshData::TETRA ){
+			m_ptrMeshData = new MeshDataTetraElement;
+		}else{
+			m_ptrMeshData = new MeshDataNonConformingHexaElement;
+		}
+		sharedMeshCache.attachMeshData(m_ptrMeshData);
+		isAttached = true;
 	}else{
-		std::cerr << "Unsupported mesh type: " << meshType << std::endl;
-	}
-	m_ptrMeshData->inputMeshData();
-	m_resistivityBlock.inputResisitivityBlock(m_numIteration);
-	std::set<int> elementsSelected ;
-	selectElements(m_ptrMeshData, elementsSelected);
-	m_resistivityBlock.changeResistivityOfSelectedElements(elementsSelected, m_modifiedResistivity, m_modifiedMinResistivity, m_modifiedMaxResistivity );
-	m_resistivityBlock.outputResisitivityBlock(m_ptrMeshData, m_numIteration);
-	const bool isTetra = ( meshType.substr(0,5).compare("TETRA") == 0 ) ? true : false;
-	m_resistivityBlock.outputResistivityValuesToBinary(isTetra, m_ptrMeshData, m_numIteration);
+		std::ifstream inFile( "mesh.dat", std::ios::in );
+		if( inFile.fail() )
+		{
+			std::cerr << "File open error : mesh.dat !!" << std::endl;
+			exit(1);
+		}
+		std::string meshType;
+		inFile >> meshType;
+		std::cout << "Mesh type: " << meshType << std::endl;
+		if( meshType.substr(0,5).compare("TETRA") == 0 ){
+			m_ptrMeshData = new MeshDataTetraElement;
+		}else if( meshType.substr(0,5).compare("DHEXA") == 0 ){
+			m_ptrMeshData = new MeshDataNonConformingHexaElement;
+		}else{
+			std::cerr << "Unsupported mesh type: " << meshType << std::endl;
+		}
+		m_ptrMeshData->inputMeshData();
+		m_ptrMeshData->reorderBySpaceFillingCurve();
+		if( !m_sharedMeshName.empty() && sharedMeshCache.publish(m_sharedMeshName, "mesh.dat", m_ptrMeshData) ){
+			// The arrays input by this process are replaced by those in the shared memory,
+			// which may have been published by another process started at the same time
+			const int meshType = m_ptrMeshData->getMeshType();
+			delete m_ptrMeshData;
+			if( meshType == MeshData::TETRA ){
+				m_ptrMeshData = new MeshDataTetraElement;
+			}else{
+				m_ptrMeshData = new MeshDataNonConformingHexaElement;
+			}
+			sharedMeshCache.attachMeshData(m_ptrMeshData);
+			isAttached = true;
+		}
+	}
+
+	// Resistivity block models of all the iterations are input in parallel
+	m_resistivityBlocks = new ResistivityBlock[numIterations];
+#pragma omp parallel for schedule(dynamic)
+	for( int iIter = 0; iIter < numIterations; ++iIter ){
+		m_resistivityBlocks[iIter].inputResisitivityBlock(m_iterations[iIter]);
+	}
+
+	ElementSelector* ptrSelector = NULL;
+	if( isMeshRequired ){
+		for( int iIter = 0; iIter < numIterations; ++iIter ){
+			m_resistivityBlocks[iIter].calcBoundingBoxesOfBlocks(m_ptrMeshData);
+		}
+		const double* xCenter = NULL;
+		const double* yCenter = NULL;
+		const double* zCenter = NULL;
+		if( isAttached ){
+			sharedMeshCache.getCenters(xCenter, yCenter, zCenter);
+		}
+		ptrSelector = new ElementSelector(m_ptrMeshData, xCenter, yCenter, zCenter);
+		typeOfMesh = m_ptrMeshData->getMeshType();
+		numElemTotal = m_ptrMeshData->getNumElemTotal();
+	}
+	if( !m_reportFile.empty() ){
+		addMemoryUsageToReport(m_ptrMeshData, ptrSelector);
+	}
+	const bool isTetra = ( typeOfMesh == MeshData::TETRA ) ? true : false;
+
+	if( !m_socketPath.empty() ){
+		// Only the first iteration is used in the server mode
+		Server server(isTetra, m_ptrMeshData, &m_resistivityBlocks[0], ptrSelector, m_iterations[0]);
+		server.run(m_socketPath);
+	}else{
+		executeScenarios(isTetra, numElemTotal, m_ptrMeshData, ptrSelector);
+	}
+
+	delete ptrSelector;
+	ptrSelector = NULL;
+	delete [] m_scenarios;
+	m_scenarios = NULL;
+	delete m_checkerboard;
+	m_checkerboard = NULL;
+	delete m_multiRegion;
+	m_multiRegion = NULL;
+	delete [] m_resistivityBlocks;
+	m_resistivityBlocks = NULL;
+
+	if( !m_reportFile.empty() ){
+		PerformanceReport::outputReport(m_reportFile);
+	}
+	if( !m_traceFile.empty() ){
+		Tracer::outputTrace(m_traceFile);
+	}
+	if( m_numTasksFailedVerification > 0 ){
+		std::cerr << "Verification against the reference implementation failed for " << m_numTasksFailedVerification << " tasks !!" << std::endl;
+		exit(1);
+	}
 }
 
 void readParameterFile( const std::string& paramFile ){
@@ -116,123 +325,326 @@ void readParameterFile( const std::string& paramFile ){
 		exit(1);
 	}
 
-	ifs >> m_numIteration;
+	// Batch mode, checkerboard mode and multi-region mode are specified by the keyword at the top of the file
+	std::string sbuf;
+	ifs >> sbuf;
+	const bool isBatchMode = ( sbuf.compare("BATCH") == 0 );
+	const bool isCheckerboardMode = ( sbuf.compare("CHECKERBOARD") == 0 );
+	const bool isMultiRegionMode = ( sbuf.compare("MULTIREGION") == 0 );
+	if( isBatchMode || isCheckerboardMode || isMultiRegionMode ){
+		ifs >> m_numIteration;
+	}else{
+		std::istringstream iss(sbuf);
+		iss >> m_numIteration;
+	}
 	std::cout << "Iteration number : " << m_numIteration<< std::endl;
 
-	ifs >> m_regionType;
-	switch (m_regionType){
-		case ELLIPSOID:
-			std::cout << "Region type : Ellipsoid" << std::endl;
-			break;
-		case CUBOID:
-			std::cout << "Region type : Cuboid" << std::endl;
-			break;
-		case CYLINDROID:
-			std::cout << "Region type : Cylindroid" << std::endl;
-			break;
-		default:
-			std::cout << "Region type is wrong : " << m_regionType << std::endl;
-			exit(1);
+	if( isCheckerboardMode ){
+		m_checkerboard = new Checkerboard;
+		m_checkerboard->readParameters(ifs);
+		ifs.close();
+		return;
 	}
 
-	switch (m_regionType){
-		case ELLIPSOID:
-			// Go through
-		case CUBOID:
-			// Go through
-		case CYLINDROID:
-			ifs >> m_length.xLength;
-			std::cout << "Length of x axis [km] : " << m_length.xLength << std::endl;
-			ifs >> m_length.yLength;
-			std::cout << "Length of y axis [km] : " << m_length.yLength << std::endl;
-			ifs >> m_length.zLength;
-			std::cout << "Length of z axis [km] : " << m_length.zLength << std::endl;
-			m_length.xLength *= 1000.0 * 0.5; 
-			m_length.yLength *= 1000.0 * 0.5; 
-			m_length.zLength *= 1000.0 * 0.5; 
-			break;
-		default:
-			std::cout << "Region type is wrong : " << m_regionType << std::endl;
+	if( isMultiRegionMode ){
+		m_multiRegion = new MultiRegion;
+		m_multiRegion->readParameters(ifs);
+		ifs.close();
+		return;
+	}
+
+	if( isBatchMode ){
+		ifs >> m_numScenarios;
+		std::cout << "Number of scenarios : " << m_numScenarios << std::endl;
+		if( m_numScenarios < 1 ){
+			std::cerr << "Number of scenarios must be positive !!" << std::endl;
 			exit(1);
+		}
+	}else{
+		m_numScenarios = 1;
+	}
+
+	m_scenarios = new Scenario[m_numScenarios];
+	for( int iScenario = 0; iScenario < m_numScenarios; ++iScenario ){
+		if( isBatchMode ){
+			std::cout << "Scenario " << iScenario << std::endl;
+		}
+		m_scenarios[iScenario].readParameters(ifs, isBatchMode);
 	}
 
-	ifs >> m_center.X;
-	std::cout << "X coordinate of the center [km] : " << m_center.X << std::endl;
-	ifs >> m_center.Y;
-	std::cout << "Y coordinate of the center [km] : " << m_center.Y << std::endl;
-	ifs >> m_center.Z;
-	std::cout << "Z coordinate of the center [km] : " << m_center.Z << std::endl;
-	ifs >> m_angle;
-	std::cout << "Rotation angle [deg.] : " << m_angle << std::endl;
-	m_center.X *= 1000.0;
-	m_center.Y *= 1000.0;
-	m_center.Z *= 1000.0;
-	m_angle *= CommonParameters::deg2rad;
-
-	ifs >> m_minResistivityForSelecting;
-	std::cout << "Minimum resistivity for selecting parameter cells [Ohm-m] :  " << m_minResistivityForSelecting << std::endl;
-	ifs >> m_maxResistivityForSelecting;
-	std::cout << "Maximum resistivity for selecting parameter cells [Ohm-m] :  " << m_maxResistivityForSelecting << std::endl;
-
-	ifs >> m_modifiedResistivity;
-	std::cout << "Modified resistivity [Ohm-m] :  " << m_modifiedResistivity << std::endl;
-	ifs >> m_modifiedMinResistivity;
-	std::cout << "Modified minimum resistivity [Ohm-m] :  " << m_modifiedMinResistivity << std::endl;
-	ifs >> m_modifiedMaxResistivity;
-	std::cout << "Modified maximum resistivity [Ohm-m] :  " << m_modifiedMaxResistivity << std::endl;
+	// Scenarios executed concurrently must not write to the same output files
+	if( m_numScenarioThreads != 1 ){
+		std::set<std::string> outputPrefixes;
+		for( int iScenario = 0; iScenario < m_numScenarios; ++iScenario ){
+			const std::string& prefix = m_scenarios[iScenario].getOutputPrefix();
+			if( !outputPrefixes.insert(prefix).second ){
+				std::cerr << "Prefix of output files of scenario " << iScenario << " is the same as that of another scenario : \"" << prefix << "\" !!" << std::endl;
+				std::cerr << "Use different prefixes or specify -threads 1 <numThreadsPerScenario> !!" << std::endl;
+				exit(1);
+			}
+		}
+	}
 
 	ifs.close();
 
 }
 
-void selectElements( const MeshData* const MeshData, std::set<int>& elementsSelected ){
+// Parse list of iteration numbers such as 3,5,7-9
+void parseIterations( const std::string& iterations ){
 
-	const int numElemTotal = MeshData->getNumElemTotal();
-	for( int iElem = 0; iElem < numElemTotal; ++iElem ){
-		const int iBlk = m_resistivityBlock.getBlockFromElement(iElem);
-		if( !m_resistivityBlock.isFixedResistivityValue(iBlk) ){
-			const CommonParameters::locationXYZ coord = MeshData->getElementCenter(iElem);
-			const double resistivity = m_resistivityBlock.getResistivityValueFromBlockIndex(iBlk);
-			if( inRegion(coord) && resistivity >= m_minResistivityForSelecting && resistivity <= m_maxResistivityForSelecting ){
-				elementsSelected.insert(iElem);
+	std::istringstream iss( iterations );
+	std::string item;
+	while( std::getline( iss, item, ',' ) ){
+		int first(0);
+		int last(0);
+		char cbuf('\0');
+		std::istringstream issItem( item );
+		if( !( issItem >> first ) ){
+			std::cerr << "Iteration number is wrong : " << item << std::endl;
+			exit(1);
+		}
+		last = first;
+		if( issItem >> cbuf ){
+			if( cbuf != '-' || !( issItem >> last ) || last < first ){
+				std::cerr << "Range of iteration numbers is wrong : " << item << std::endl;
+				exit(1);
 			}
 		}
+		for( int iter = first; iter <= last; ++iter ){
+			m_iterations.push_back(iter);
+		}
+	}
+	if( m_iterations.empty() ){
+		std::cerr << "List of iteration numbers is empty !!" << std::endl;
+		exit(1);
+	}
+
+	std::cout << "Iteration numbers :";
+	for( std::vector<int>::const_iterator itr = m_iterations.begin(); itr != m_iterations.end(); ++itr ){
+		std::cout << " " << *itr;
+	}
+	std::cout << std::endl;
+
+}
+
+// Look up the selected elements of all the tasks in the cache
+// [note] : True is returned if the selections of all the tasks are found
+bool lookUpSelectionCache( int& meshType, int& numElemTotal ){
+
+	m_selectionCache.setDirectory(m_cacheDirectory);
+
+	// Hash values of the mesh file and the resistivity block files
+	const int numIterations = static_cast<int>( m_iterations.size() );
+	std::vector<std::string> fileNames;
+	fileNames.push_back("mesh.dat");
+	for( int iIter = 0; iIter < numIterations; ++iIter ){
+		std::ostringstream oss;
+		oss << "resistivity_block_iter" << m_iterations[iIter] << ".dat";
+		fileNames.push_back(oss.str());
+	}
+	const int numFiles = static_cast<int>( fileNames.size() );
+	std::vector<unsigned long long> hashes( numFiles, 0 );
+#pragma omp parallel for schedule(dynamic)
+	for( int iFile = 0; iFile < numFiles; ++iFile ){
+		hashes[iFile] = m_selectionCache.getHashOfFile(fileNames[iFile]);
+	}
+
+	const int numTasks = numIterations * m_numScenarios;
+	m_cacheKeys.resize(numTasks);
+	m_cachedSelections.resize(numTasks);
+	m_isCached.assign(numTasks, 0);
+	for( int iTask = 0; iTask < numTasks; ++iTask ){
+		const int iIter = iTask / m_numScenarios;
+		const int iScenario = iTask % m_numScenarios;
+		std::ostringstream oss;
+		oss << "MESH " << std::hex << hashes[0] << std::endl;
+		oss << "BLOCK " << hashes[iIter + 1] << std::dec << std::endl;
+		m_scenarios[iScenario].writeCanonicalSelectionParameters(oss);
+		m_cacheKeys[iTask] = oss.str();
+	}
+
+	std::vector<int> meshTypes( numTasks, 0 );
+	std::vector<int> numElems( numTasks, 0 );
+#pragma omp parallel for schedule(dynamic)
+	for( int iTask = 0; iTask < numTasks; ++iTask ){
+		if( m_selectionCache.load(m_cacheKeys[iTask], meshTypes[iTask], numElems[iTask], m_cachedSelections[iTask]) ){
+			m_isCached[iTask] = 1;
+		}
+	}
+
+	int numTasksCached(0);
+	for( int iTask = 0; iTask < numTasks; ++iTask ){
+		if( m_isCached[iTask] != 0 ){
+			meshType = meshTypes[iTask];
+			numElemTotal = numElems[iTask];
+			++numTasksCached;
+		}
 	}
+	std::cout << "Number of the selections found in the cache : " << numTasksCached << " / " << numTasks << std::endl;
 
-	std::cout << "Number of the selected elements : " << elementsSelected.size() << std::endl;
+	return numTasksCached == numTasks;
 
 }
 
-bool inRegion( const CommonParameters::locationXYZ& coord ){
+// Add allocated bytes of the mesh data, the resistivity blocks, the selector and the cache to the performance report
+void addMemoryUsageToReport( const MeshData* const ptrMeshData, const ElementSelector* const ptrSelector ){
 
-	const CommonParameters::locationXYZ coordFromCenter = { coord.X - m_center.X, coord.Y - m_center.Y, coord.Z - m_center.Z }; 
-	CommonParameters::locationXYZ coordRotated = { 0.0, 0.0, 0.0};
-	coordRotated.X = coordFromCenter.X * cos( - m_angle ) - coordFromCenter.Y * sin( - m_angle );
-	coordRotated.Y = coordFromCenter.X * sin( - m_angle ) + coordFromCenter.Y * cos( - m_angle );
-	coordRotated.Z = coordFromCenter.Z;
-	
-	if( m_regionType == ELLIPSOID ){
-		const double val = pow( coordRotated.X / m_length.xLength, 2 ) + pow( coordRotated.Y / m_length.yLength, 2 ) + pow( coordRotated.Z / m_length.zLength, 2 );
-		if( val <= 1.0 ){
-			return true;
+	if( ptrMeshData != NULL ){
+		ptrMeshData->addMemoryUsageToReport("mesh");
+	}
+	for( int iIter = 0; iIter < static_cast<int>( m_iterations.size() ); ++iIter ){
+		std::ostringstream prefix;
+		prefix << "resistivity_block_iter" << m_iterations[iIter];
+		m_resistivityBlocks[iIter].addMemoryUsageToReport( prefix.str() );
+	}
+	if( ptrSelector != NULL ){
+		ptrSelector->addMemoryUsageToReport("element_selector");
+	}
+	if( !m_cachedSelections.empty() ){
+		long long bytes(0);
+		for( std::vector< std::set<int> >::const_iterator itr = m_cachedSelections.begin(); itr != m_cachedSelections.end(); ++itr ){
+			bytes += static_cast<long long>( itr->size() ) * PerformanceReport::calcTreeNodeSize( static_cast<long long>( sizeof(int) ) );
 		}
+		PerformanceReport::addMemoryUsage( "selection_cache.selected_elements", bytes );
 	}
-	else if( m_regionType == CUBOID ){
-		if( fabs(coordRotated.X) <= m_length.xLength && fabs(coordRotated.Y) <= m_length.yLength && fabs(coordRotated.Z) <= m_length.zLength ){
-			return true;
+
+}
+
+// Execute scenarios concurrently
+// Each pair of an iteration and a scenario, or the checkerboard or multi-region model, is executed as a task.
+// [note] : Messages of each task are buffered and written in the order of the tasks
+// [note] : Mesh data and the selector may be NULL if the selections of all the scenarios are found in the cache
+void executeScenarios( const bool isTetra, const int numElemTotal, const MeshData* const ptrMeshData, const ElementSelector* const ptrSelector ){
+
+	const int numIterations = static_cast<int>( m_iterations.size() );
+	const int numModels = ( m_checkerboard != NULL || m_multiRegion != NULL ) ? 1 : m_numScenarios;
+	const int numTasks = numIterations * numModels;
+
+	// Eligibility is shared by the scenarios having the same resistivity range
+	std::vector<double> rangesMin;
+	std::vector<double> rangesMax;
+	std::vector<int> rangeOfModels(numModels, -1);
+	for( int iModel = 0; iModel < numModels; ++iModel ){
+		double resistivityMin(0.0);
+		double resistivityMax(0.0);
+		if( m_checkerboard != NULL ){
+			resistivityMin = m_checkerboard->getResistivityMin();
+			resistivityMax = m_checkerboard->getResistivityMax();
+		}else if( m_multiRegion != NULL ){
+			resistivityMin = m_multiRegion->getResistivityMin();
+			resistivityMax = m_multiRegion->getResistivityMax();
+		}else{
+			resistivityMin = m_scenarios[iModel].getSelectionParameters().resistivityMin;
+			resistivityMax = m_scenarios[iModel].getSelectionParameters().resistivityMax;
+		}
+		for( int i = 0; i < static_cast<int>( rangesMin.size() ); ++i ){
+			if( rangesMin[i] == resistivityMin && rangesMax[i] == resistivityMax ){
+				rangeOfModels[iModel] = i;
+				break;
+			}
+		}
+		if( rangeOfModels[iModel] < 0 ){
+			rangesMin.push_back(resistivityMin);
+			rangesMax.push_back(resistivityMax);
+			rangeOfModels[iModel] = static_cast<int>( rangesMin.size() ) - 1;
 		}
 	}
-	else if( m_regionType == CYLINDROID ){
-		const double val = pow( coordRotated.X / m_length.xLength, 2 ) + pow( coordRotated.Y / m_length.yLength, 2 );
-		if( val <= 1.0 && fabs(coordRotated.Z) <= m_length.zLength ){
-			return true;
+	const int numRanges = static_cast<int>( rangesMin.size() );
+	std::vector<unsigned char> isEligibilityRequired( numIterations * numRanges, 0 );
+	for( int iTask = 0; iTask < numTasks; ++iTask ){
+		if( m_isCached.empty() || m_isCached[iTask] == 0 ){
+			isEligibilityRequired[ ( iTask / numModels ) * numRanges + rangeOfModels[ iTask % numModels ] ] = 1;
 		}
 	}
-	else{
-		std::cout << "Region type is wrong : " << m_regionType << std::endl;
-		exit(1);
+	std::vector<ElementSelector::Eligibility> eligibilities( numIterations * numRanges );
+#pragma omp parallel for schedule(dynamic)
+	for( int i = 0; i < numIterations * numRanges; ++i ){
+		if( isEligibilityRequired[i] == 0 ){
+			continue;
+		}
+		const int iIter = i / numRanges;
+		const int iRange = i % numRanges;
+		ptrSelector->calcEligibility(m_resistivityBlocks[iIter], rangesMin[iRange], rangesMax[iRange], eligibilities[i]);
+	}
+
+	// By default, as many tasks as the available threads are executed concurrently
+	int numScenarioThreads = m_numScenarioThreads;
+	if( numScenarioThreads <= 0 ){
+#ifdef _USE_OMP
+		numScenarioThreads = omp_get_max_threads();
+#else
+		numScenarioThreads = 1;
+#endif
+	}
+	numScenarioThreads = std::min( numScenarioThreads, numTasks );
+#ifdef _USE_OMP
+	int numThreadsPerScenario = m_numThreadsPerScenario;
+	if( numThreadsPerScenario <= 0 ){
+		// Available threads are divided among the concurrent tasks
+		numThreadsPerScenario = std::max( omp_get_max_threads() / numScenarioThreads, 1 );
+	}
+	if( numScenarioThreads > 1 ){
+		std::cout << "Number of tasks executed concurrently : " << numScenarioThreads << std::endl;
+		std::cout << "Number of threads used in each task : " << numThreadsPerScenario << std::endl;
+		omp_set_max_active_levels(2);
+	}
+#endif
+
+	std::ostringstream* logs = new std::ostringstream[numTasks];
+	std::vector<unsigned char> isFinished( numTasks, 0 );
+	int numTasksOutput(0);
+
+#pragma omp parallel for schedule(dynamic) num_threads(numScenarioThreads)
+	for( int iTask = 0; iTask < numTasks; ++iTask ){
+#ifdef _USE_OMP
+		omp_set_num_threads(numThreadsPerScenario);
+#endif
+		const int iIter = iTask / numModels;
+		const int iModel = iTask % numModels;
+		std::ostringstream taskName;
+		taskName << "task " << iTask << " ( iteration " << m_iterations[iIter] << ", model " << iModel << " )";
+		Tracer::Event event("task", taskName.str());
+		const ResistivityBlock& resistivityBlock = m_resistivityBlocks[iIter];
+		const ElementSelector::Eligibility& eligibility = eligibilities[ iIter * numRanges + rangeOfModels[iModel] ];
+		if( numIterations > 1 ){
+			logs[iTask] << "Iteration " << m_iterations[iIter] << std::endl;
+		}
+		if( m_checkerboard != NULL ){
+			m_checkerboard->execute(isTetra, ptrMeshData, resistivityBlock, *ptrSelector, eligibility, m_iterations[iIter], logs[iTask]);
+		}else if( m_multiRegion != NULL ){
+			m_multiRegion->execute(isTetra, ptrMeshData, resistivityBlock, *ptrSelector, eligibility, m_iterations[iIter], logs[iTask]);
+		}else{
+			if( m_numScenarios > 1 ){
+				logs[iTask] << "Scenario " << iModel << " : " << m_scenarios[iModel].getOutputPrefix() << std::endl;
+			}
+			std::set<int> elementsSelected;
+			if( !m_isCached.empty() && m_isCached[iTask] != 0 ){
+				logs[iTask] << "Selected elements are read from the cache" << std::endl;
+				elementsSelected.swap( m_cachedSelections[iTask] );
+			}else{
+				m_scenarios[iModel].selectElements(resistivityBlock, *ptrSelector, eligibility, elementsSelected);
+				if( !m_cacheKeys.empty() ){
+#pragma omp critical (storeSelectionCache)
+					m_selectionCache.store(m_cacheKeys[iTask], ptrMeshData->getMeshType(), numElemTotal, elementsSelected);
+				}
+			}
+			m_scenarios[iModel].modifyResistivity(isTetra, numElemTotal, resistivityBlock, elementsSelected, m_iterations[iIter], logs[iTask]);
+			if( m_verify && !m_scenarios[iModel].verify(isTetra, numElemTotal, resistivityBlock, *ptrSelector, elementsSelected, m_iterations[iIter], logs[iTask]) ){
+#pragma omp atomic
+				++m_numTasksFailedVerification;
+			}
+		}
+#pragma omp critical (outputLogOfScenarios)
+		{
+			isFinished[iTask] = 1;
+			while( numTasksOutput < numTasks && isFinished[numTasksOutput] != 0 ){
+				std::cout << logs[numTasksOutput].str() << std::flush;
+				logs[numTasksOutput].str("");
+				++numTasksOutput;
+			}
+		}
 	}
 
-	return false;
+	delete [] logs;
 
 }
@@ -0,0 +1,109 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <stdlib.h>
+
+#include "MeshData.h"
+#include "SyntheticMeshGenerator.h"
+
+// Program generating mesh.dat and resistivity_block_iterN.dat of a synthetic model for benchmarking
+// Usage : makeSyntheticMesh <TETRA|DHEXA> <number of elements> [options]
+//   -cells nx ny nz : Numbers of the cells along the axes, which are used instead of the number of elements
+//   -air n          : Number of the air layers
+//   -refined n      : Number of the earth layers refined horizontally ( DHEXA only )
+//   -size h t       : Horizontal size of the cells and thickness of the layers [m]
+//   -block n        : Number of the cells of a resistivity block along each axis
+//   -seed n         : Seed of the resistivity values of the blocks
+//   -iter n         : Iteration number of the resistivity block file
+int main( int argc, char* argv[] ){
+
+	if( argc < 3 ){
+		std::cerr << "Usage : makeSyntheticMesh <TETRA|DHEXA> <number of elements> [-cells nx ny nz] [-air n] [-refined n] [-size h t] [-block n] [-seed n] [-iter n]" << std::endl;
+		exit(1);
+	}
+
+	SyntheticMeshGenerator::Parameters params;
+	const std::string meshType = argv[1];
+	if( meshType.compare("TETRA") == 0 ){
+		params.meshType = MeshData::TETRA;
+	}else if( meshType.compare("DHEXA") == 0 ){
+		params.meshType = MeshData::DHEXA;
+	}else{
+		std::cerr << "Unsupported mesh type: " << meshType << std::endl;
+		exit(1);
+	}
+	const long long numElemTarget = atoll( argv[2] );
+	SyntheticMeshGenerator::calcNumCellsFromNumElements( params.meshType, numElemTarget, params );
+	params.cellSize = 1000.0;
+	params.layerThickness = 500.0;
+	params.numCellsOfBlock = 2;
+	params.seed = 1;
+	int iterNum(0);
+
+	for( int i = 3; i < argc; ++i ){
+		const std::string option = argv[i];
+		if( option.compare("-cells") == 0 && i + 3 < argc ){
+			params.numCellsX = atoi( argv[++i] );
+			params.numCellsY = atoi( argv[++i] );
+			params.numCellsZ = atoi( argv[++i] );
+		}else if( option.compare("-air") == 0 && i + 1 < argc ){
+			params.numAirLayers = atoi( argv[++i] );
+		}else if( option.compare("-refined") == 0 && i + 1 < argc ){
+			params.numRefinedLayers = atoi( argv[++i] );
+		}else if( option.compare("-size") == 0 && i + 2 < argc ){
+			params.cellSize = atof( argv[++i] );
+			params.layerThickness = atof( argv[++i] );
+		}else if( option.compare("-block") == 0 && i + 1 < argc ){
+			params.numCellsOfBlock = atoi( argv[++i] );
+		}else if( option.compare("-seed") == 0 && i + 1 < argc ){
+			params.seed = static_cast<unsigned int>( atoi( argv[++i] ) );
+		}else if( option.compare("-iter") == 0 && i + 1 < argc ){
+			iterNum = atoi( argv[++i] );
+		}else{
+			std::cerr << "Unknown option or missing arguments : " << option << std::endl;
+			exit(1);
+		}
+	}
+
+	const SyntheticMeshGenerator generator(params);
+	std::cout << "Mesh type: " << meshType << std::endl;
+	std::cout << "Numbers of the cells : " << params.numCellsX << " x " << params.numCellsY << " x " << params.numCellsZ << std::endl;
+	std::cout << "Number of the air layers : " << params.numAirLayers << std::endl;
+	if( params.meshType == MeshData::DHEXA ){
+		std::cout << "Number of the refined layers : " << params.numRefinedLayers << std::endl;
+	}
+	std::cout << "Total number of nodes : " << generator.getNumNodeTotal() << std::endl;
+	std::cout << "Total number of elements : " << generator.getNumElemTotal() << std::endl;
+	std::cout << "Total number of resistivity blocks : " << generator.getNumResistivityBlockTotal() << std::endl;
+
+	generator.writeMeshData("mesh.dat");
+	std::ostringstream blockFile;
+	blockFile << "resistivity_block_iter" << iterNum << ".dat";
+	generator.writeResistivityBlock( blockFile.str() );
+
+	return 0;
+
+}
@@ -0,0 +1,474 @@
+//--------------------------------------------------------------------------
+// MIT License
+//
+// Copyright (c) 2021 Yoshiya Usui
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//--------------------------------------------------------------------------
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#ifdef _LINUX
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
+#ifdef _USE_OMP
+#include <omp.h>
+#endif
+
+#include "PerformanceReport.h"
+
+// Program of thread-scaling benchmark of the whole pipeline of changeResistivity
+// changeResistivity is run in the current directory with each number of threads. The times of the phases in its
+// performance report are written to a CSV file together with the speedups and the efficiencies.
+// Usage : scalingBenchmark <parameter file> [options] [-- options of changeResistivity]
+//   -threads list : Numbers of threads such as 1,2,4,8 ( default : powers of two up to the number of processors )
+//   -repeat n     : Number of runs with each number of threads, whose medians are used ( default : 3 )
+//                   At least six runs are needed for 95 % intervals, and nine or more make them narrower than the range
+//   -csv file     : Output CSV file ( default : scaling.csv )
+//   -program path : Path of changeResistivity ( default : ./changeResistivity )
+//   -store file   : Store the medians and their confidence intervals as a baseline
+//   -compare file : Compare the results with a baseline and exit with nonzero status if any of them regresses
+//   -tolerance x  : Relative increase of the median time allowed in the comparison ( default : 0.1 )
+//   -min-time sec : Phases whose median times are shorter than this are not compared ( default : 0.01 )
+// [note] : The speedups and the efficiencies are relative to the first number of threads.
+//          A time regresses only if its median exceeds the baseline by more than the tolerance and
+//          the lower bound of its confidence interval exceeds the upper bound of the baseline.
+//          The confidence intervals of the medians are at the 95 % level from exact binomial order statistics.
+//          A warm-up run which is not measured precedes the runs with each number of threads.
+
+namespace{
+
+// Results of the runs with a number of threads
+struct ScalingResult{
+	// Number of threads
+	int numThreads;
+	// Medians of the wall clock time, the CPU time and the peak resident set size of the process
+	double wallTime;
+	double cpuTime;
+	double peakRSS;
+	// Confidence interval of the median of the wall clock time
+	double wallTimeLower;
+	double wallTimeUpper;
+	// Medians of the spans of the phases
+	double phaseTimes[PerformanceReport::NUM_PHASES];
+	// Confidence intervals of the medians of the spans of the phases
+	double phaseTimesLower[PerformanceReport::NUM_PHASES];
+	double phaseTimesUpper[PerformanceReport::NUM_PHASES];
+};
+
+// Statistics of a time stored in the baseline
+struct BaselineEntry{
+	// Number of threads
+	int numThreads;
+	// Name of the time
+	std::string name;
+	// Median and its confidence interval
+	double median;
+	double lower;
+	double upper;
+};
+
+// Calculate median of values
+double calcMedian( std::vector<double> values ){
+
+	std::sort( values.begin(), values.end() );
+	const int num = static_cast<int>( values.size() );
+	if( num == 0 ){
+		return 0.0;
+	}
+	return num % 2 == 1 ? values[num / 2] : 0.5 * ( values[num / 2 - 1] + values[num / 2] );
+
+}
+
+// Calculate 95% confidence interval of median of values from their order statistics
+// [note] : The range of the values is used when the number of the values is too small
+void calcConfidenceIntervalOfMedian( std::vector<double> values, double& lower, double& upper ){
+
+	std::sort( values.begin(), values.end() );
+	const int num = static_cast<int>( values.size() );
+	if( num == 0 ){
+		lower = 0.0;
+		upper = 0.0;
+		return;
+	}
+	// The interval between the k-th smallest and the k-th largest values contains the median with the probability
+	// 1 - 2 * P( B <= k - 1 ) for B ~ Binomial( n, 1/2 ). The largest k giving at least 95 % is used.
+	int rank(1);
+	double probability = pow( 0.5, num );
+	double cumulative = probability;
+	for( int k = 2; 2 * k <= num + 1; ++k ){
+		probability *= static_cast<double>( num - k + 2 ) / static_cast<double>( k - 1 );
+		cumulative += probability;
+		if( 1.0 - 2.0 * cumulative < 0.95 ){
+			break;
+		}
+		rank = k;
+	}
+	lower = values[rank - 1];
+	upper = values[num - rank];
+
+}
+
+// Store the medians and their confidence intervals as a baseline
+void storeBaseline( const std::string& fileName, const std::vector<ScalingResult>& results ){
+
+	FILE* fp = fopen( fileName.c_str(), "w" );
+	if( fp == NULL ){
+		std::cerr << "File open error : " << fileName << " !!" << std::endl;
+		exit(1);
+	}
+	fprintf( fp, "%10d\n", static_cast<int>( results.size() ) * ( PerformanceReport::NUM_PHASES + 1 ) );
+	for( std::vector<ScalingResult>::const_iterator itr = results.begin(); itr != results.end(); ++itr ){
+		fprintf( fp, "%10d %-20s %15e %15e %15e\n", itr->numThreads, "total", itr->wallTime, itr->wallTimeLower, itr->wallTimeUpper );
+		for( int iPhase = 0; iPhase < PerformanceReport::NUM_PHASES; ++iPhase ){
+			fprintf( fp, "%10d %-20s %15e %15e %15e\n", itr->numThreads, PerformanceReport::getPhaseName(iPhase),
+				itr->phaseTimes[iPhase], itr->phaseTimesLower[iPhase], itr->phaseTimesUpper[iPhase] );
+		}
+	}
+	fclose( fp );
+	std::cout << "Baseline is stored to " << fileName << std::endl;
+
+}
+
+// Compare a time with the baseline and return whether it regresses
+bool compareTimeWithBaseline( const std::vector<BaselineEntry>& baseline, const int numThreads, const std::string& name,
+	const double median, const double lower, const double upper, const double tolerance, const double minTime ){
+
+	const BaselineEntry* ptrEntry = NULL;
+	for( std::vector<BaselineEntry>::const_iterator itr = baseline.begin(); itr != baseline.end(); ++itr ){
+		if( itr->numThreads == numThreads && itr->name.compare(name) == 0 ){
+			ptrEntry = &(*itr);
+			break;
+		}
+	}
+	if( ptrEntry == NULL ){
+		printf( "%8d %-20s %12s %12.6f [%10.6f,%10.6f] %9s %s\n", numThreads, name.c_str(), "-", median, lower, upper, "-", "not in baseline" );
+		return false;
+	}
+
+	const double change = ptrEntry->median > 0.0 ? ( median - ptrEntry->median ) / ptrEntry->median : 0.0;
+	std::string status = "ok";
+	bool regresses(false);
+	if( median < minTime && ptrEntry->median < minTime ){
+		status = "too short";
+	}else if( median > ptrEntry->median * ( 1.0 + tolerance ) && lower > ptrEntry->upper ){
+		status = "REGRESSION";
+		regresses = true;
+	}else if( median < ptrEntry->median * ( 1.0 - tolerance ) && upper < ptrEntry->lower ){
+		status = "improved";
+	}
+	printf( "%8d %-20s %12.6f %12.6f [%10.6f,%10.6f] %+8.1f%% %s\n", numThreads, name.c_str(), ptrEntry->median, median, lower, upper, change * 100.0, status.c_str() );
+	return regresses;
+
+}
+
+// Compare the results with a baseline and return whether any of them regresses
+bool compareWithBaseline( const std::string& fileName, const std::vector<ScalingResult>& results, const double tolerance, const double minTime ){
+
+	std::ifstream ifs( fileName.c_str(), std::ios::in );
+	if( ifs.fail() ){
+		std::cerr << "File open error : " << fileName << " !!" << std::endl;
+		exit(1);
+	}
+	int numEntries(0);
+	ifs >> numEntries;
+	std::vector<BaselineEntry> baseline;
+	for( int i = 0; i < numEntries; ++i ){
+		BaselineEntry entry;
+		ifs >> entry.numThreads >> entry.name >> entry.median >> entry.lower >> entry.upper;
+		if( ifs.fail() ){
+			std::cerr << "Baseline file " << fileName << " is broken !!" << std::endl;
+			exit(1);
+		}
+		baseline.push_back(entry);
+	}
+	ifs.close();
+
+	std::cout << "Comparison with the baseline " << fileName << " ( tolerance : " << tolerance * 100.0 << "% )" << std::endl;
+	printf( "%8s %-20s %12s %12s %23s %9s %s\n", "Threads", "Time", "Baseline[s]", "Current[s]", "95% CI[s]", "Change", "Status" );
+	bool regresses(false);
+	for( std::vector<ScalingResult>::const_iterator itr = results.begin(); itr != results.end(); ++itr ){
+		if( compareTimeWithBaseline( baseline, itr->numThreads, "total", itr->wallTime, itr->wallTimeLower, itr->wallTimeUpper, tolerance, minTime ) ){
+			regresses = true;
+		}
+		for( int iPhase = 0; iPhase < PerformanceReport::NUM_PHASES; ++iPhase ){
+			if( compareTimeWithBaseline( baseline, itr->numThreads, PerformanceReport::getPhaseName(iPhase),
+				itr->phaseTimes[iPhase], itr->phaseTimesLower[iPhase], itr->phaseTimesUpper[iPhase], tolerance, minTime ) ){
+				regresses = true;
+			}
+		}
+	}
+	return regresses;
+
+}
+
+// Read value of a key from the performance report
+// The key is searched in the object of the specified name or from the top of the report if the name is empty
+double readValueFromReport( const std::string& report, const std::string& objectName, const std::string& key ){
+
+	std::string::size_type start(0);
+	std::string::size_type end(std::string::npos);
+	if( !objectName.empty() ){
+		start = report.find( "\"" + objectName + "\": {" );
+		if( start == std::string::npos ){
+			std::cerr << "Object " << objectName << " is not found in the performance report !!" << std::endl;
+			exit(1);
+		}
+		end = report.find( "}", start );
+	}
+	const std::string pattern = "\"" + key + "\": ";
+	const std::string::size_type pos = report.find( pattern, start );
+	if( pos == std::string::npos || ( end != std::string::npos && pos > end ) ){
+		std::cerr << "Key " << key << " is not found in the performance report !!" << std::endl;
+		exit(1);
+	}
+	return atof( report.c_str() + pos + pattern.size() );
+
+}
+
+// Run changeResistivity with the specified number of threads and read its performance report
+void runProgram( const std::string& program, const std::vector<std::string>& arguments, const int numThreads, const std::string& reportFile,
+	double& wallTime, double& cpuTime, double& peakRSS, double* phaseTimes ){
+
+#ifdef _LINUX
+	std::vector<char*> argv;
+	argv.push_back( const_cast<char*>( program.c_str() ) );
+	for( std::vector<std::string>::const_iterator itr = arguments.begin(); itr != arguments.end(); ++itr ){
+		argv.push_back( const_cast<char*>( itr->c_str() ) );
+	}
+	argv.push_back( NULL );
+
+	std::ostringstream oss;
+	oss << numThreads;
+	const std::string threads = oss.str();
+
+	const pid_t pid = fork();
+	if( pid < 0 ){
+		std::cerr << "Failed to create a process !!" << std::endl;
+		exit(1);
+	}
+	if( pid == 0 ){
+		// The log of changeResistivity is discarded
+		setenv( "OMP_NUM_THREADS", threads.c_str(), 1 );
+		const int fd = open( "/dev/null", O_WRONLY );
+		if( fd >= 0 ){
+			dup2( fd, STDOUT_FILENO );
+			close(fd);
+		}
+		execv( program.c_str(), &argv[0] );
+		std::cerr << "Failed to execute " << program << " !!" << std::endl;
+		_exit(127);
+	}
+	int status(0);
+	if( waitpid( pid, &status, 0 ) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0 ){
+		std::cerr << program << " failed with " << numThreads << " threads !!" << std::endl;
+		exit(1);
+	}
+#else
+	std::cerr << "Thread-scaling benchmark is supported only on Linux !!" << std::endl;
+	exit(1);
+#endif
+
+	std::ifstream ifs( reportFile.c_str(), std::ios::in );
+	if( ifs.fail() ){
+		std::cerr << "File open error : " << reportFile << " !!" << std::endl;
+		exit(1);
+	}
+	std::ostringstream report;
+	report << ifs.rdbuf();
+	ifs.close();
+
+	wallTime = readValueFromReport( report.str(), "", "wall_time" );
+	cpuTime = readValueFromReport( report.str(), "", "cpu_time" );
+	peakRSS = readValueFromReport( report.str(), "", "peak_rss" );
+	for( int iPhase = 0; iPhase < PerformanceReport::NUM_PHASES; ++iPhase ){
+		// Span is used because the times of the calls executed concurrently are summed up in the wall time of a phase
+		phaseTimes[iPhase] = readValueFromReport( report.str(), PerformanceReport::getPhaseName(iPhase), "span" );
+	}
+
+}
+
+// Parse list of numbers of threads such as 1,2,4,8
+void parseNumThreads( const std::string& list, std::vector<int>& numThreads ){
+
+	std::istringstream iss( list );
+	std::string item;
+	while( std::getline( iss, item, ',' ) ){
+		const int num = atoi( item.c_str() );
+		if( num < 1 ){
+			std::cerr << "Number of threads must be positive : " << item << std::endl;
+			exit(1);
+		}
+		numThreads.push_back(num);
+	}
+
+}
+
+}
+
+int main( int argc, char* argv[] ){
+
+	if( argc < 2 ){
+		std::cerr << "Usage : scalingBenchmark <parameter file> [-threads list] [-repeat n] [-csv file] [-program path]" << std::endl;
+		std::cerr << "                         [-store file] [-compare file] [-tolerance x] [-min-time sec] [-- options of changeResistivity]" << std::endl;
+		exit(1);
+	}
+
+	const std::string paramFile = argv[1];
+	std::vector<int> numThreads;
+	int numRepeats(3);
+	std::string csvFile = "scaling.csv";
+	std::string program = "./changeResistivity";
+	std::string baselineFileToStore = "";
+	std::string baselineFileToCompare = "";
+	double tolerance(0.1);
+	double minTime(0.01);
+	std::vector<std::string> extraArguments;
+	for( int i = 2; i < argc; ++i ){
+		const std::string option = argv[i];
+		if( option.compare("-threads") == 0 && i + 1 < argc ){
+			parseNumThreads( argv[++i], numThreads );
+		}else if( option.compare("-repeat") == 0 && i + 1 < argc ){
+			numRepeats = std::max( atoi( argv[++i] ), 1 );
+		}else if( option.compare("-csv") == 0 && i + 1 < argc ){
+			csvFile = argv[++i];
+		}else if( option.compare("-program") == 0 && i + 1 < argc ){
+			program = argv[++i];
+		}else if( option.compare("-store") == 0 && i + 1 < argc ){
+			baselineFileToStore = argv[++i];
+		}else if( option.compare("-compare") == 0 && i + 1 < argc ){
+			baselineFileToCompare = argv[++i];
+		}else if( option.compare("-tolerance") == 0 && i + 1 < argc ){
+			tolerance = atof( argv[++i] );
+		}else if( option.compare("-min-time") == 0 && i + 1 < argc ){
+			minTime = atof( argv[++i] );
+		}else if( option.compare("--") == 0 ){
+			for( ++i; i < argc; ++i ){
+				extraArguments.push_back( argv[i] );
+			}
+		}else{
+			std::cerr << "Unknown option or missing arguments : " << option << std::endl;
+			exit(1);
+		}
+	}
+
+	if( !baselineFileToCompare.empty() && numRepeats < 6 ){
+		std::cout << "Warning : Confidence level of the intervals is below 95 % for fewer than six runs" << std::endl;
+	}
+
+	if( numThreads.empty() ){
+		int numProcs(1);
+#ifdef _USE_OMP
+		numProcs = omp_get_num_procs();
+#endif
+		for( int num = 1; num < numProcs; num *= 2 ){
+			numThreads.push_back(num);
+		}
+		numThreads.push_back(numProcs);
+	}
+
+	const std::string reportFile = "scaling_report.json";
+	std::vector<std::string> arguments;
+	arguments.push_back( paramFile );
+	arguments.insert( arguments.end(), extraArguments.begin(), extraArguments.end() );
+	arguments.push_back( "-report" );
+	arguments.push_back( reportFile );
+
+	std::vector<ScalingResult> results;
+	for( std::vector<int>::const_iterator itr = numThreads.begin(); itr != numThreads.end(); ++itr ){
+		std::vector<double> wallTimes;
+		std::vector<double> cpuTimes;
+		std::vector<double> peakRSSs;
+		std::vector<double> phaseTimes[PerformanceReport::NUM_PHASES];
+		// The first run is a warm-up, which keeps effects of the page cache and the first touch out of the samples
+		for( int iRepeat = -1; iRepeat < numRepeats; ++iRepeat ){
+			double wallTime(0.0);
+			double cpuTime(0.0);
+			double peakRSS(0.0);
+			double times[PerformanceReport::NUM_PHASES];
+			runProgram( program, arguments, *itr, reportFile, wallTime, cpuTime, peakRSS, times );
+			if( iRepeat < 0 ){
+				continue;
+			}
+			wallTimes.push_back(wallTime);
+			cpuTimes.push_back(cpuTime);
+			peakRSSs.push_back(peakRSS);
+			for( int iPhase = 0; iPhase < PerformanceReport::NUM_PHASES; ++iPhase ){
+				phaseTimes[iPhase].push_back( times[iPhase] );
+			}
+		}
+		ScalingResult result;
+		result.numThreads = *itr;
+		result.wallTime = calcMedian(wallTimes);
+		result.cpuTime = calcMedian(cpuTimes);
+		result.peakRSS = calcMedian(peakRSSs);
+		calcConfidenceIntervalOfMedian( wallTimes, result.wallTimeLower, result.wallTimeUpper );
+		for( int iPhase = 0; iPhase < PerformanceReport::NUM_PHASES; ++iPhase ){
+			result.phaseTimes[iPhase] = calcMedian( phaseTimes[iPhase] );
+			calcConfidenceIntervalOfMedian( phaseTimes[iPhase], result.phaseTimesLower[iPhase], result.phaseTimesUpper[iPhase] );
+		}
+		results.push_back(result);
+		std::cout << "Number of threads : " << *itr << ", Wall time [sec] : " << result.wallTime << std::endl;
+	}
+	remove( reportFile.c_str() );
+
+	FILE* fp = fopen( csvFile.c_str(), "w" );
+	if( fp == NULL ){
+		std::cerr << "File open error : " << csvFile << " !!" << std::endl;
+		exit(1);
+	}
+	fprintf( fp, "threads,runs,wall_time,cpu_time,peak_rss,speedup,efficiency" );
+	for( int iPhase = 0; iPhase < PerformanceReport::NUM_PHASES; ++iPhase ){
+		fprintf( fp, ",%s_time,%s_speedup", PerformanceReport::getPhaseName(iPhase), PerformanceReport::getPhaseName(iPhase) );
+	}
+	fprintf( fp, "\n" );
+	const ScalingResult& base = results.front();
+	for( std::vector<ScalingResult>::const_iterator itr = results.begin(); itr != results.end(); ++itr ){
+		const double speedup = itr->wallTime > 0.0 ? base.wallTime / itr->wallTime : 0.0;
+		const double efficiency = speedup * static_cast<double>( base.numThreads ) / static_cast<double>( itr->numThreads );
+		fprintf( fp, "%d,%d,%.6f,%.6f,%.0f,%.4f,%.4f", itr->numThreads, numRepeats, itr->wallTime, itr->cpuTime, itr->peakRSS, speedup, efficiency );
+		for( int iPhase = 0; iPhase < PerformanceReport::NUM_PHASES; ++iPhase ){
+			const double phaseSpeedup = itr->phaseTimes[iPhase] > 0.0 ? base.phaseTimes[iPhase] / itr->phaseTimes[iPhase] : 0.0;
+			fprintf( fp, ",%.6f,%.4f", itr->phaseTimes[iPhase], phaseSpeedup );
+		}
+		fprintf( fp, "\n" );
+	}
+	fclose( fp );
+	std::cout << "Results are written to " << csvFile << std::endl;
+
+	if( !baselineFileToStore.empty() ){
+		storeBaseline( baselineFileToStore, results );
+	}
+	if( !baselineFileToCompare.empty() && compareWithBaseline( baselineFileToCompare, results, tolerance, minTime ) ){
+		std::cerr << "Performance regresses from the baseline !!" << std::endl;
+		return 1;
+	}
+
+	return 0;
+
+}